@@ -0,0 +1,145 @@
+/**
+ * @file bench_harness.hpp
+ * @brief A small multi-threaded benchmark harness for rmutexpp.
+ *
+ * Benchmarks register themselves with `RMUTEX_BENCHMARK(name)` and receive a
+ * `run_context` describing the thread count and per-thread iteration budget. The
+ * body hands a per-thread callable to `run_context::run_threads`, which starts all
+ * workers behind a barrier, samples wall time and `perf_counters` around the
+ * measured region only, and records how many lock acquisitions were performed.
+ * Every counter is reported per acquisition (per operation for scenario benchmarks).
+ */
+#ifndef _RMUTEX_BENCH_HARNESS_HEADER_
+#define _RMUTEX_BENCH_HARNESS_HEADER_
+
+#include <atomic>   // For std::atomic
+#include <chrono>   // For std::chrono::steady_clock
+#include <cstdint>  // For std::uint64_t
+#include <string>   // For std::string
+#include <thread>   // For std::thread, std::this_thread::yield
+#include <utility>  // For std::pair
+#include <vector>   // For std::vector
+
+#include "perf_counters.hpp"
+
+namespace rmutexpp::bench {
+
+  /**
+   * @struct run_context
+   * @brief Parameters and results of a single benchmark run.
+   */
+  struct run_context {
+      unsigned       threads;     ///< Number of worker threads to start.
+      std::uint64_t  iterations;  ///< Lock acquisitions each worker should perform.
+      perf_counters& counters;    ///< Counters opened for this run, before any worker exists.
+      double         skew = 0.99; ///< Zipfian exponent used by scenario benchmarks to pick keys.
+      std::uint64_t  keys = 1024; ///< Key space (accounts, config entries, cache keys) of scenario benchmarks.
+
+      std::uint64_t                                operations = 0;  ///< Total lock acquisitions performed.
+      double                                       seconds    = 0;  ///< Wall time of the measured region.
+      counter_sample                               sample { };      ///< Counter totals of the measured region.
+      std::vector<std::pair<std::string, double>> metrics { };     ///< Benchmark-specific extra results.
+
+      /**
+       * @brief Runs `body(thread_index)` on `threads` workers and measures it.
+       *
+       * Thread creation is kept out of the measured region: the clock and the counters
+       * start once every worker is waiting on the start flag, and stop after all of
+       * them have been joined.
+       *
+       * @param body Callable invoked as `body(unsigned)`, returning the number of lock
+       * acquisitions it performed.
+       */
+      template <typename F>
+      void run_threads(F&& body) {
+        std::atomic<unsigned>      ready { 0 };
+        std::atomic<bool>          go { false };
+        std::vector<std::uint64_t> per_thread(threads, 0);
+        std::vector<std::thread>   workers;
+        workers.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) {
+          workers.emplace_back([&, i]() {
+            ready.fetch_add(1, std::memory_order_relaxed);
+            while (!go.load(std::memory_order_acquire)) {
+              std::this_thread::yield();
+            }
+            per_thread[i] = body(i);
+          });
+        }
+        while (ready.load(std::memory_order_relaxed) != threads) {
+          std::this_thread::yield();
+        }
+        counters.start();
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (std::thread& worker : workers) {
+          worker.join();
+        }
+        auto stop = std::chrono::steady_clock::now();
+        sample    = counters.stop();
+        seconds   = std::chrono::duration<double>(stop - start).count();
+        for (std::uint64_t count : per_thread) {
+          operations += count;
+        }
+      }
+  };
+
+  /// @brief Signature of a registered benchmark body.
+  using benchmark_fn = void (*)(run_context&);
+
+  /**
+   * @struct benchmark
+   * @brief A named entry of the benchmark registry.
+   */
+  struct benchmark {
+      std::string  name;
+      benchmark_fn fn;
+  };
+
+  /**
+   * @brief The process-wide list of registered benchmarks.
+   * @return A reference to the registry, in registration order.
+   */
+  inline std::vector<benchmark>& registry() {
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+  }
+
+  /**
+   * @struct registrar
+   * @brief Adds a benchmark to the registry during static initialization.
+   */
+  struct registrar {
+      registrar(const char* name, benchmark_fn fn) { registry().push_back({ name, fn }); }
+  };
+
+  /**
+   * @brief Prevents the optimizer from discarding a value computed by a benchmark.
+   * @param value The value to keep alive.
+   */
+  template <typename T>
+  inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static const T* volatile sink;
+    sink = &value;
+#endif
+  }
+}  // namespace rmutexpp::bench
+
+#define RMUTEX_BENCH_CONCAT_IMPL(a, b) a##b
+#define RMUTEX_BENCH_CONCAT(a, b)      RMUTEX_BENCH_CONCAT_IMPL(a, b)
+
+/**
+ * @def RMUTEX_BENCHMARK
+ * @brief Defines and registers a benchmark body taking a `run_context& ctx`.
+ */
+#define RMUTEX_BENCHMARK(name)                                                                                         \
+  static void                          RMUTEX_BENCH_CONCAT(rmutex_bench_fn_, __LINE__)(::rmutexpp::bench::run_context&); \
+  static const ::rmutexpp::bench::registrar RMUTEX_BENCH_CONCAT(rmutex_bench_reg_, __LINE__) {                          \
+    name, &RMUTEX_BENCH_CONCAT(rmutex_bench_fn_, __LINE__)                                                              \
+  };                                                                                                                    \
+  static void RMUTEX_BENCH_CONCAT(rmutex_bench_fn_, __LINE__)([[maybe_unused]] ::rmutexpp::bench::run_context & ctx)
+
+#endif  // _RMUTEX_BENCH_HARNESS_HEADER_
@@ -0,0 +1,342 @@
+// rmutexpp/benchmark/bench_main.cpp
+//
+// Command line driver of the rmutexpp benchmark harness.
+//
+//   rmutex_benchmarks [--filter=<substring>,...] [--threads=1,2,4] [--iterations=N]
+//                     [--repetitions=N] [--skew=<theta>] [--keys=N] [--json=<path>]
+//                     [--no-counters] [--oversubscribe=4,8,16] [--cpus=N]
+//
+// --filter runs the benchmarks whose name contains any of the comma-separated substrings.
+//
+// With --repetitions every benchmark is run N times; the console shows the run with
+// the median time and the JSON report keeps every sample for compare.py, together with
+// the host name, CPU model and CPU count it was recorded on.
+//
+// --cpus=N pins the process to the first N CPUs it may run on (Linux). With
+// --oversubscribe the thread counts become multiples of the available CPUs, a 1x run
+// is always included as reference, and every run reports its throughput relative to
+// it as the `vs_1x` metric.
+
+#include <algorithm>  // For std::any_of, std::max, std::sort
+#include <cstdio>     // For std::printf, std::fprintf, std::FILE
+#include <cstdlib>    // For std::strtoull
+#include <cstring>    // For std::strncmp
+#include <fstream>    // For std::ifstream
+#include <string>     // For std::string, std::stoul, std::stod
+#include <thread>     // For std::thread::hardware_concurrency
+#include <vector>     // For std::vector
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include "bench_harness.hpp"
+
+using namespace rmutexpp::bench;
+
+namespace {
+  struct options {
+      std::vector<std::string> filters;
+      std::vector<unsigned>    threads;
+      std::uint64_t            iterations  = 200000;
+      unsigned                 repetitions = 1;
+      double                   skew        = 0.99;
+      std::uint64_t            keys        = 1024;
+      std::string              json_path;
+      bool                     counters = true;
+      std::vector<unsigned>    oversubscribe;
+      unsigned                 cpus = 0;
+  };
+
+  /// @brief Where a report was recorded; compare.py refuses to compare reports of different hosts.
+  struct host_info {
+      std::string name      = "unknown";
+      std::string cpu_model = "unknown";
+      unsigned    cpus      = 0;  ///< CPUs the benchmarks could run on, after --cpus.
+  };
+
+  struct result {
+      std::string    name;
+      unsigned       threads;
+      std::uint64_t  operations;
+      double         seconds;
+      counter_sample sample;
+      std::vector<std::pair<std::string, double>> metrics;
+      std::vector<double>                          samples;  ///< ns/op of every repetition.
+
+      double ns_per_op() const { return operations ? seconds * 1e9 / static_cast<double>(operations) : 0.0; }
+  };
+
+  std::vector<unsigned> default_threads() {
+    unsigned              hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threads { 1 };
+    for (unsigned n = 2; n < hardware; n *= 2) {
+      threads.push_back(n);
+    }
+    if (hardware > 1) {
+      threads.push_back(hardware);
+    }
+    return threads;
+  }
+
+  // Restricts the process to its first `cpus` allowed CPUs and returns how many CPUs it may use.
+  unsigned pin_to_cpus(unsigned cpus) {
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+      if (cpus > 0) {
+        cpu_set_t pinned;
+        CPU_ZERO(&pinned);
+        unsigned taken = 0;
+        for (int cpu = 0; cpu < CPU_SETSIZE && taken < cpus; ++cpu) {
+          if (CPU_ISSET(cpu, &allowed)) {
+            CPU_SET(cpu, &pinned);
+            ++taken;
+          }
+        }
+        // Worker threads inherit the affinity of the main thread.
+        if (sched_setaffinity(0, sizeof(pinned), &pinned) == 0) {
+          return taken;
+        }
+        std::fprintf(stderr, "sched_setaffinity failed; running unpinned\n");
+      }
+      return static_cast<unsigned>(CPU_COUNT(&allowed));
+    }
+#else
+    if (cpus > 0) {
+      std::fprintf(stderr, "--cpus is only supported on Linux; running unpinned\n");
+    }
+#endif
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  bool parse_flag(const char* arg, const char* flag, std::string& value) {
+    std::size_t length = std::strlen(flag);
+    if (std::strncmp(arg, flag, length) != 0 || arg[length] != '=') {
+      return false;
+    }
+    value = arg + length + 1;
+    return true;
+  }
+
+  std::vector<std::string> split_list(const std::string& list) {
+    std::vector<std::string> items;
+    std::size_t              begin = 0;
+    while (begin < list.size()) {
+      std::size_t end = list.find(',', begin);
+      if (end == std::string::npos) {
+        end = list.size();
+      }
+      items.push_back(list.substr(begin, end - begin));
+      begin = end + 1;
+    }
+    return items;
+  }
+
+  std::vector<unsigned> parse_list(const std::string& list) {
+    std::vector<unsigned> values;
+    for (const std::string& item : split_list(list)) {
+      values.push_back(static_cast<unsigned>(std::stoul(item)));
+    }
+    return values;
+  }
+
+  bool selected(const std::string& name, const std::vector<std::string>& filters) {
+    return filters.empty() ||
+           std::any_of(filters.begin(), filters.end(), [&](const std::string& filter) { return name.find(filter) != std::string::npos; });
+  }
+
+  host_info describe_host(unsigned cpus) {
+    host_info host;
+    host.cpus = cpus;
+#if defined(__linux__)
+    char name[256] = { };
+    if (gethostname(name, sizeof(name) - 1) == 0 && name[0]) {
+      host.name = name;
+    }
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    for (std::string line; std::getline(cpuinfo, line);) {
+      if (line.rfind("model name", 0) == 0) {
+        std::size_t colon = line.find(':');
+        if (colon != std::string::npos && colon + 2 <= line.size()) {
+          host.cpu_model = line.substr(colon + 2);
+        }
+        break;
+      }
+    }
+#endif
+    return host;
+  }
+
+  // Escapes the characters that cannot appear verbatim inside a JSON string.
+  std::string json_escape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+      if (c == '"' || c == '\\') {
+        escaped += '\\';
+      }
+      if (static_cast<unsigned char>(c) >= 0x20) {
+        escaped += c;
+      }
+    }
+    return escaped;
+  }
+
+  void print_per_op(const std::optional<std::uint64_t>& total, std::uint64_t operations) {
+    if (total && operations) {
+      std::printf(" %12.4g", static_cast<double>(*total) / static_cast<double>(operations));
+    } else {
+      std::printf(" %12s", "n/a");
+    }
+  }
+
+  void print_header() {
+    std::printf("%-48s %7s %12s %12s", "benchmark", "threads", "ns/op", "Mops/s");
+    for (const char* name : counter_names) {
+      std::printf(" %12s", name);
+    }
+    std::printf("\n");
+  }
+
+  void print_result(const result& r) {
+    double mops = r.seconds > 0 ? static_cast<double>(r.operations) / r.seconds / 1e6 : 0.0;
+    std::printf("%-48s %7u %12.2f %12.3f", r.name.c_str(), r.threads, r.ns_per_op(), mops);
+    for (std::size_t i = 0; i < counter_names.size(); ++i) {
+      print_per_op(r.sample.values[i], r.operations);
+    }
+    for (const auto& [key, value] : r.metrics) {
+      std::printf("  %s=%.4g", key.c_str(), value);
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+  }
+
+  void write_json(const std::string& path, const host_info& host, const std::vector<result>& results) {
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) {
+      std::fprintf(stderr, "cannot open %s for writing\n", path.c_str());
+      return;
+    }
+    std::fprintf(out, "{\n  \"host\": {\"name\": \"%s\", \"cpu_model\": \"%s\", \"cpus\": %u},\n",
+                 json_escape(host.name).c_str(), json_escape(host.cpu_model).c_str(), host.cpus);
+    std::fprintf(out, "  \"benchmarks\": [\n");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      const result& r = results[i];
+      std::fprintf(out, "    {\"name\": \"%s\", \"threads\": %u, \"operations\": %llu, \"seconds\": %.9g, \"ns_per_op\": %.6g",
+                   r.name.c_str(), r.threads, static_cast<unsigned long long>(r.operations), r.seconds, r.ns_per_op());
+      std::fprintf(out, ", \"per_op\": {");
+      for (std::size_t c = 0; c < counter_names.size(); ++c) {
+        const auto& total = r.sample.values[c];
+        if (total && r.operations) {
+          std::fprintf(out, "%s\"%s\": %.6g", c ? ", " : "", counter_names[c], static_cast<double>(*total) / static_cast<double>(r.operations));
+        } else {
+          std::fprintf(out, "%s\"%s\": null", c ? ", " : "", counter_names[c]);
+        }
+      }
+      std::fprintf(out, "}, \"metrics\": {");
+      for (std::size_t m = 0; m < r.metrics.size(); ++m) {
+        std::fprintf(out, "%s\"%s\": %.6g", m ? ", " : "", r.metrics[m].first.c_str(), r.metrics[m].second);
+      }
+      std::fprintf(out, "}, \"samples\": [");
+      for (std::size_t s = 0; s < r.samples.size(); ++s) {
+        std::fprintf(out, "%s%.6g", s ? ", " : "", r.samples[s]);
+      }
+      std::fprintf(out, "]}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+    std::fclose(out);
+  }
+}  // namespace
+
+int main(int argc, char** argv) {
+  options     opts;
+  std::string value;
+  for (int i = 1; i < argc; ++i) {
+    if (parse_flag(argv[i], "--filter", value)) {
+      opts.filters = split_list(value);
+    } else if (parse_flag(argv[i], "--threads", value)) {
+      opts.threads = parse_list(value);
+    } else if (parse_flag(argv[i], "--iterations", value)) {
+      opts.iterations = std::strtoull(value.c_str(), nullptr, 10);
+    } else if (parse_flag(argv[i], "--repetitions", value)) {
+      opts.repetitions = std::max(1u, static_cast<unsigned>(std::stoul(value)));
+    } else if (parse_flag(argv[i], "--skew", value)) {
+      opts.skew = std::stod(value);
+    } else if (parse_flag(argv[i], "--keys", value)) {
+      opts.keys = std::max<std::uint64_t>(2, std::strtoull(value.c_str(), nullptr, 10));
+    } else if (parse_flag(argv[i], "--json", value)) {
+      opts.json_path = value;
+    } else if (std::strcmp(argv[i], "--no-counters") == 0) {
+      opts.counters = false;
+    } else if (parse_flag(argv[i], "--oversubscribe", value)) {
+      opts.oversubscribe = parse_list(value);
+    } else if (parse_flag(argv[i], "--cpus", value)) {
+      opts.cpus = static_cast<unsigned>(std::stoul(value));
+    } else {
+      std::fprintf(stderr, "usage: %s [--filter=<substring>,...] [--threads=1,2,4] [--iterations=N] [--repetitions=N] "
+                   "[--skew=<theta>] [--keys=N] [--json=<path>] [--no-counters] [--oversubscribe=4,8,16] [--cpus=N]\n",
+                   argv[0]);
+      return 2;
+    }
+  }
+  unsigned cpus = pin_to_cpus(opts.cpus);
+  if (!opts.oversubscribe.empty()) {
+    opts.threads = { cpus };
+    for (unsigned factor : opts.oversubscribe) {
+      if (factor > 1) {
+        opts.threads.push_back(factor * cpus);
+      }
+    }
+    std::printf("oversubscribing %u cpu(s)\n", cpus);
+  } else if (opts.threads.empty()) {
+    opts.threads = default_threads();
+  }
+
+  {
+    perf_counters probe(opts.counters);
+    std::printf("counters:");
+    for (std::size_t c = 0; c < counter_names.size(); ++c) {
+      bool available = probe.available(static_cast<counter>(c));
+      std::printf(" %s=%s", counter_names[c], available ? "perf" : (c == static_cast<std::size_t>(counter::context_switches) ? "rusage" : "n/a"));
+    }
+    std::printf("\n");
+  }
+
+  std::vector<result> results;
+  print_header();
+  for (const benchmark& bench : registry()) {
+    if (!selected(bench.name, opts.filters)) {
+      continue;
+    }
+    double reference_mops = 0;
+    for (unsigned threads : opts.threads) {
+      std::vector<result> runs;
+      for (unsigned repetition = 0; repetition < opts.repetitions; ++repetition) {
+        perf_counters counters(opts.counters);
+        run_context   ctx { .threads = threads, .iterations = opts.iterations, .counters = counters, .skew = opts.skew, .keys = opts.keys };
+        bench.fn(ctx);
+        runs.push_back({ bench.name, threads, ctx.operations, ctx.seconds, ctx.sample, std::move(ctx.metrics), {} });
+      }
+      std::sort(runs.begin(), runs.end(), [](const result& a, const result& b) { return a.ns_per_op() < b.ns_per_op(); });
+      result median = runs[runs.size() / 2];
+      for (const result& run : runs) {
+        median.samples.push_back(run.ns_per_op());
+      }
+      if (!opts.oversubscribe.empty()) {
+        double mops = median.seconds > 0 ? static_cast<double>(median.operations) / median.seconds / 1e6 : 0.0;
+        if (threads == cpus) {
+          reference_mops = mops;
+        }
+        median.metrics.emplace_back("vs_1x", reference_mops > 0 ? mops / reference_mops : 0.0);
+      }
+      results.push_back(std::move(median));
+      print_result(results.back());
+    }
+  }
+  if (!opts.json_path.empty()) {
+    write_json(opts.json_path, describe_host(cpus), results);
+  }
+  return 0;
+}
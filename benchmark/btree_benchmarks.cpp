@@ -0,0 +1,75 @@
+// rmutexpp/benchmark/btree_benchmarks.cpp
+//
+// Ordered index throughput: olc_btree (optimistic lock coupling) against the usual
+// rmutex<std::map>. Both indexes are prefilled with `prefilled_keys` keys; every
+// operation then looks up a uniformly random key, and one operation in
+// `insert_period` inserts (or overwrites) one instead. Meant to be swept over
+//
+//   rmutex_benchmarks --filter=btree/ --threads=1,2,4,8,16,32,64
+//
+// Each run reports `hit_rate` as a sanity check that both indexes hold the same keys.
+
+#include <cstdint>  // For std::uint64_t
+#include <map>      // For std::map
+#include <vector>   // For std::vector
+
+#include "bench_harness.hpp"
+#include "rmutexpp/olc_btree.hpp"
+#include "rmutexpp/rmutex.hpp"
+#include "zipfian.hpp"
+
+using namespace rmutexpp;
+using namespace rmutexpp::bench;
+
+namespace {
+  constexpr std::uint64_t prefilled_keys = 1 << 20;
+  constexpr std::uint64_t insert_period  = 10;  // 90% lookups, 10% inserts.
+
+  // Keys are spread over twice the prefilled range, so about half the lookups miss.
+  std::uint64_t random_key(splitmix64& random) { return random.next() % (2 * prefilled_keys); }
+
+  template <typename Index, typename Insert, typename Find>
+  void index_workload(run_context& ctx, Index& index, Insert insert, Find find) {
+    for (std::uint64_t key = 0; key < 2 * prefilled_keys; key += 2) {
+      insert(index, key, key);
+    }
+    std::vector<std::uint64_t> hits(ctx.threads, 0);
+    ctx.run_threads([&](unsigned thread) {
+      splitmix64    random(thread + 1);
+      std::uint64_t hit = 0;
+      for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+        std::uint64_t key = random_key(random);
+        if (i % insert_period == 0) {
+          insert(index, key, i);
+        } else {
+          hit += find(index, key) ? 1 : 0;
+        }
+      }
+      hits[thread] = hit;
+      return ctx.iterations;
+    });
+    std::uint64_t total = 0;
+    for (std::uint64_t count : hits) {
+      total += count;
+    }
+    double lookups = static_cast<double>(ctx.operations) * (insert_period - 1) / insert_period;
+    ctx.metrics.emplace_back("hit_rate", static_cast<double>(total) / lookups);
+  }
+}  // namespace
+
+RMUTEX_BENCHMARK("btree/rmutex_map") {
+  rmutex<std::map<std::uint64_t, std::uint64_t>> index;
+  index_workload(
+      ctx, index, [](auto& map, std::uint64_t key, std::uint64_t value) { (*map.lock())[key] = value; },
+      [](auto& map, std::uint64_t key) {
+        rmutex_ref locked = map.lock();
+        return locked->find(key) != locked->end();
+      });
+}
+
+RMUTEX_BENCHMARK("btree/olc_btree") {
+  olc_btree<std::uint64_t, std::uint64_t> index;
+  index_workload(
+      ctx, index, [](auto& tree, std::uint64_t key, std::uint64_t value) { tree.insert_or_assign(key, value); },
+      [](auto& tree, std::uint64_t key) { return tree.contains(key); });
+}
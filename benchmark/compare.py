@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# rmutexpp/benchmark/compare.py
+#
+# Compares a rmutex_benchmarks JSON report against a stored baseline.
+#
+#   compare.py <baseline.json> <current.json> [--threshold=0.10] [--alpha=0.05]
+#   compare.py <baseline.json>      (only checks that the baseline exists)
+#
+# Every benchmark present in both reports is compared on its per-repetition ns/op
+# samples with a one-sided Mann-Whitney U test ("current is slower than baseline").
+# A benchmark regresses when the test is significant at --alpha AND the median slowed
+# down by more than --threshold (a fraction, 0.10 = 10%). The script exits with status
+# 1 if any benchmark regressed, so it can gate CI. Only the standard library is used.
+#
+# Timings are only comparable on the same machine: when the reports differ in host name,
+# CPU model or CPU count, the script prints a warning, skips the comparison and exits
+# with status 0. A missing baseline is an error (status 2): record one first on the
+# machine that runs the comparisons (target benchmark_baseline).
+
+import argparse
+import json
+import math
+import os
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    return report.get("host"), {(b["name"], b["threads"]): b for b in report["benchmarks"]}
+
+
+def describe(host):
+    if host is None:
+        return "no host recorded"
+    return f"{host['name']} ({host['cpu_model']}, {host['cpus']} CPUs)"
+
+
+def median(values):
+    ordered = sorted(values)
+    mid = len(ordered) // 2
+    return ordered[mid] if len(ordered) % 2 else (ordered[mid - 1] + ordered[mid]) / 2
+
+
+def mann_whitney_greater(current, baseline):
+    """One-sided p-value for H1: samples of `current` tend to be larger than `baseline`.
+
+    Uses the normal approximation with tie and continuity corrections; with fewer than
+    three samples per side no test is meaningful and 1.0 is returned.
+    """
+    n1, n2 = len(current), len(baseline)
+    if n1 < 3 or n2 < 3:
+        return 1.0
+    pooled = sorted([(v, 0) for v in current] + [(v, 1) for v in baseline])
+    ranks = [0.0] * len(pooled)
+    tie_term = 0.0
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        rank = (i + j) / 2 + 1
+        for k in range(i, j + 1):
+            ranks[k] = rank
+        ties = j - i + 1
+        tie_term += ties ** 3 - ties
+        i = j + 1
+    rank_sum = sum(r for r, (_, group) in zip(ranks, pooled) if group == 0)
+    u = rank_sum - n1 * (n1 + 1) / 2
+    n = n1 + n2
+    mean = n1 * n2 / 2
+    variance = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    z = (u - mean - 0.5) / math.sqrt(variance)
+    return 0.5 * math.erfc(z / math.sqrt(2))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline")
+    parser.add_argument("current", nargs="?")
+    parser.add_argument("--threshold", type=float, default=0.10)
+    parser.add_argument("--alpha", type=float, default=0.05)
+    args = parser.parse_args()
+
+    if not os.path.exists(args.baseline):
+        print(f"no baseline at {args.baseline}: record one on this machine first (target benchmark_baseline)",
+              file=sys.stderr)
+        return 2
+    if args.current is None:
+        return 0
+    baseline_host, baseline = load(args.baseline)
+    current_host, current = load(args.current)
+    if baseline_host is None or baseline_host != current_host:
+        print(f"WARNING: the baseline was recorded on another host, skipping the comparison:\n"
+              f"  baseline: {describe(baseline_host)}\n"
+              f"  current:  {describe(current_host)}\n"
+              f"re-record {args.baseline} on this machine (target benchmark_baseline)", file=sys.stderr)
+        return 0
+
+    regressions = 0
+    print(f"{'benchmark':<48} {'threads':>7} {'base ns/op':>12} {'new ns/op':>12} {'change':>8} {'p':>8}  verdict")
+    for key in sorted(current):
+        name, threads = key
+        if key not in baseline:
+            print(f"{name:<48} {threads:>7} {'-':>12} {median(current[key]['samples']):>12.2f} {'-':>8} {'-':>8}  new")
+            continue
+        old_samples = baseline[key]["samples"]
+        new_samples = current[key]["samples"]
+        old_median = median(old_samples)
+        new_median = median(new_samples)
+        change = (new_median - old_median) / old_median if old_median else 0.0
+        p = mann_whitney_greater(new_samples, old_samples)
+        regressed = p < args.alpha and change > args.threshold
+        verdict = "REGRESSION" if regressed else ("slower" if change > args.threshold else "ok")
+        regressions += regressed
+        print(f"{name:<48} {threads:>7} {old_median:>12.2f} {new_median:>12.2f} {change:>+8.1%} {p:>8.4f}  {verdict}")
+    for key in sorted(set(baseline) - set(current)):
+        print(f"{key[0]:<48} {key[1]:>7} {'':>12} {'':>12} {'':>8} {'':>8}  missing")
+
+    if regressions:
+        print(f"{regressions} benchmark(s) regressed by more than {args.threshold:.0%} (alpha={args.alpha})")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,83 @@
+// rmutexpp/benchmark/construction_benchmarks.cpp
+//
+// Construction and relocation cost of rmutex<T> for a large T:
+//
+//   construction/from_value   builds a 4 KiB payload, then moves it into the rmutex
+//   construction/in_place     builds the payload directly inside the rmutex
+//   relocation/move           move-constructs one rmutex<std::string> from another
+//   relocation/vector_growth  emplace_back into a std::vector<rmutex<std::string>>
+//                             without reserve(); every growth relocates all elements
+//
+// Every operation is one construction (or one emplace_back).
+
+#include <array>    // For std::array
+#include <cstdint>  // For std::uint64_t
+#include <string>   // For std::string
+#include <utility>  // For std::in_place, std::move
+#include <vector>   // For std::vector
+
+#include "bench_harness.hpp"
+#include "rmutexpp/rmutex.hpp"
+
+using namespace rmutexpp;
+using namespace rmutexpp::bench;
+
+namespace {
+  struct payload {
+      std::array<std::uint64_t, 512> words;
+
+      explicit payload(std::uint64_t seed) noexcept {
+        for (std::uint64_t& word : words) {
+          word = seed++;
+        }
+      }
+  };
+
+  constexpr std::size_t vector_growth_length = 4096;  // Elements per vector before starting over.
+}  // namespace
+
+RMUTEX_BENCHMARK("construction/from_value") {
+  ctx.run_threads([&](unsigned) {
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      rmutex<payload> built(payload { i });
+      do_not_optimize(built);
+    }
+    return ctx.iterations;
+  });
+}
+
+RMUTEX_BENCHMARK("construction/in_place") {
+  ctx.run_threads([&](unsigned) {
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      rmutex<payload> built(std::in_place, i);
+      do_not_optimize(built);
+    }
+    return ctx.iterations;
+  });
+}
+
+RMUTEX_BENCHMARK("relocation/move") {
+  ctx.run_threads([&](unsigned) {
+    rmutex<std::string> current(std::in_place, 64, 'x');
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      rmutex<std::string> next(std::move(current));
+      current = std::move(next);
+    }
+    do_not_optimize(current);
+    return ctx.iterations;
+  });
+}
+
+RMUTEX_BENCHMARK("relocation/vector_growth") {
+  ctx.run_threads([&](unsigned) {
+    std::vector<rmutex<std::string>> shards;
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      if (shards.size() == vector_growth_length) {
+        shards = std::vector<rmutex<std::string>>();
+      }
+      shards.emplace_back(std::in_place, 32, 'x');
+    }
+    do_not_optimize(shards);
+    return ctx.iterations;
+  });
+}
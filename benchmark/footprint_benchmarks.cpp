@@ -0,0 +1,116 @@
+// rmutexpp/benchmark/footprint_benchmarks.cpp
+//
+// Memory footprint and false sharing of large arrays of rmutex<T>.
+//
+// Every layout stores `array_elements` rmutex objects holding a payload of 8, 64 or
+// 256 bytes:
+//
+//   std::mutex         rmutex<T>                  (40-byte std::mutex with glibc)
+//   word_mutex         rmutex<T, word_mutex>      (4-byte lock word)
+//   padded/std::mutex  rmutex<T> aligned to its own cache line(s)
+//   padded/word_mutex  rmutex<T, word_mutex> aligned to its own cache line(s)
+//
+// and is exercised by two workloads:
+//
+//   random     every thread locks uniformly random elements and updates them, so the
+//              array footprint decides how often an acquisition misses the caches;
+//   neighbors  thread t only touches elements t, t + threads, t + 2 * threads, ...
+//              from a small window: no lock is ever contended, yet compact layouts put
+//              elements of different threads on the same cache line (false sharing).
+//
+// Each run reports `bytes_per_object` and `array_mib`; cache misses come from the
+// harness counters (llc_misses, hitm).
+
+#include <array>    // For std::array
+#include <cstdint>  // For std::uint64_t
+#include <memory>   // For std::unique_ptr
+#include <mutex>    // For std::mutex
+#include <string>   // For std::string, std::to_string
+
+#include "bench_harness.hpp"
+#include "rmutexpp/rmutex.hpp"
+#include "rmutexpp/rmutex_backends.hpp"
+#include "zipfian.hpp"
+
+using namespace rmutexpp;
+using namespace rmutexpp::bench;
+
+namespace {
+  constexpr std::size_t array_elements  = std::size_t { 1 } << 17;
+  constexpr std::size_t neighbor_window = 64;
+
+  template <std::size_t Size>
+  struct payload {
+      std::array<std::uint64_t, Size / sizeof(std::uint64_t)> words {};
+  };
+
+  template <typename Element>
+  struct plain_slot {
+      Element value;
+  };
+
+  template <typename Element>
+  struct alignas(64) padded_slot {
+      Element value;
+  };
+
+  template <typename Mutex, std::size_t Size, bool Padded>
+  using slot_t = std::conditional_t<Padded, padded_slot<rmutex<payload<Size>, Mutex>>, plain_slot<rmutex<payload<Size>, Mutex>>>;
+
+  template <typename Slot>
+  void report_footprint(run_context& ctx) {
+    ctx.metrics.emplace_back("bytes_per_object", static_cast<double>(sizeof(Slot)));
+    ctx.metrics.emplace_back("array_mib", static_cast<double>(sizeof(Slot) * array_elements) / (1024.0 * 1024.0));
+  }
+
+  template <typename Mutex, std::size_t Size, bool Padded>
+  void random_updates(run_context& ctx) {
+    using slot = slot_t<Mutex, Size, Padded>;
+    std::unique_ptr<slot[]> slots(new slot[array_elements]);
+    ctx.run_threads([&](unsigned index) {
+      splitmix64 random(index + 1);
+      for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+        auto data = slots[random.next() % array_elements].value.lock();
+        ++data->words.front();
+      }
+      return ctx.iterations;
+    });
+    report_footprint<slot>(ctx);
+  }
+
+  template <typename Mutex, std::size_t Size, bool Padded>
+  void neighbor_updates(run_context& ctx) {
+    using slot = slot_t<Mutex, Size, Padded>;
+    std::unique_ptr<slot[]> slots(new slot[neighbor_window * ctx.threads]);
+    ctx.run_threads([&](unsigned index) {
+      for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+        auto data = slots[(i % neighbor_window) * ctx.threads + index].value.lock();
+        ++data->words.front();
+      }
+      return ctx.iterations;
+    });
+    report_footprint<slot>(ctx);
+  }
+
+  template <typename Mutex, std::size_t Size, bool Padded>
+  void register_layout(const char* layout) {
+    std::string prefix = std::string("footprint/") + layout + "/T" + std::to_string(Size);
+    registry().push_back({ prefix + "/random", &random_updates<Mutex, Size, Padded> });
+    registry().push_back({ prefix + "/neighbors", &neighbor_updates<Mutex, Size, Padded> });
+  }
+
+  template <std::size_t Size>
+  void register_sizes() {
+    register_layout<std::mutex, Size, false>("std::mutex");
+    register_layout<word_mutex, Size, false>("word_mutex");
+    register_layout<std::mutex, Size, true>("padded/std::mutex");
+    register_layout<word_mutex, Size, true>("padded/word_mutex");
+  }
+
+  const bool footprint_registered = [] {
+    register_sizes<8>();
+    register_sizes<64>();
+    register_sizes<256>();
+    return true;
+  }();
+}  // namespace
@@ -0,0 +1,46 @@
+// rmutexpp/benchmark/lazy_benchmarks.cpp
+//
+// Reading a lazily built value after it has been built, from every thread:
+//
+//   lazy/rmutex_optional  rmutex<std::optional<T>>: lock, check, read, unlock
+//   lazy/once_cell        once_cell<T>::get_or_init: one acquire load
+//
+// Every operation is one access to the value.
+
+#include <cstdint>   // For std::uint64_t
+#include <optional>  // For std::optional
+
+#include "bench_harness.hpp"
+#include "rmutexpp/once_cell.hpp"
+#include "rmutexpp/rmutex.hpp"
+
+using namespace rmutexpp;
+using namespace rmutexpp::bench;
+
+RMUTEX_BENCHMARK("lazy/rmutex_optional") {
+  rmutex<std::optional<std::uint64_t>> lazy;
+  ctx.run_threads([&](unsigned) {
+    std::uint64_t sum = 0;
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      rmutex_ref value = lazy.lock();
+      if (!*value) {
+        *value = 42;
+      }
+      sum += **value;
+    }
+    do_not_optimize(sum);
+    return ctx.iterations;
+  });
+}
+
+RMUTEX_BENCHMARK("lazy/once_cell") {
+  once_cell<std::uint64_t> lazy;
+  ctx.run_threads([&](unsigned) {
+    std::uint64_t sum = 0;
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      sum += lazy.get_or_init([] { return std::uint64_t { 42 }; });
+    }
+    do_not_optimize(sum);
+    return ctx.iterations;
+  });
+}
@@ -0,0 +1,141 @@
+// rmutexpp/benchmark/oversubscription_benchmarks.cpp
+//
+// Lock-holder preemption stress for every rmutex backend. Meant to be run with more
+// threads than CPUs, e.g.
+//
+//   rmutex_benchmarks --filter=oversubscribed --oversubscribe=4,8,16 [--cpus=2]
+//
+// which runs 1x (reference), 4x, 8x and 16x as many threads as CPUs, optionally after
+// pinning the process to the first N CPUs, and reports throughput relative to the 1x
+// run as `vs_1x`. Per run it also reports:
+//
+//   preempted_holds_per_kop  critical sections that took longer than 50us, a proxy for
+//                            a lock holder being descheduled, per 1000 acquisitions;
+//   wait_cpu_ns_per_op       CPU time burnt inside lock() per acquisition (spinning),
+//                            measured whenever an initial try_lock() fails;
+//   wait_cpu_share           that CPU time as a fraction of all CPU time of the workers;
+//   invol_cs_per_kop         involuntary context switches of the workers (Linux).
+
+#include <array>    // For std::array
+#include <chrono>   // For std::chrono::steady_clock
+#include <cstdint>  // For std::uint64_t
+#include <mutex>    // For std::mutex
+#include <vector>   // For std::vector
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+#include "bench_harness.hpp"
+#include "rmutexpp/rmutex.hpp"
+#include "rmutexpp/rmutex_backends.hpp"
+#include "zipfian.hpp"
+
+using namespace rmutexpp;
+using namespace rmutexpp::bench;
+
+namespace {
+  constexpr std::uint64_t preemption_threshold_ns = 50000;
+
+  struct worker_stats {
+      std::uint64_t preempted_holds = 0;
+      std::uint64_t wait_cpu_ns     = 0;
+      std::uint64_t total_cpu_ns    = 0;
+      std::uint64_t involuntary_cs  = 0;
+  };
+
+  std::uint64_t thread_cpu_ns() {
+#if defined(__unix__) || defined(__APPLE__)
+    timespec now {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<std::uint64_t>(now.tv_sec) * 1000000000ull + static_cast<std::uint64_t>(now.tv_nsec);
+#else
+    return 0;
+#endif
+  }
+
+  // Cost of one thread_cpu_ns() reading, subtracted from every sampled wait.
+  std::uint64_t thread_cpu_clock_overhead() {
+    std::uint64_t best = ~std::uint64_t { 0 };
+    for (int i = 0; i < 32; ++i) {
+      std::uint64_t first = thread_cpu_ns();
+      std::uint64_t delta = thread_cpu_ns() - first;
+      best                = delta < best ? delta : best;
+    }
+    return best;
+  }
+
+  std::uint64_t thread_involuntary_switches() {
+#if defined(__linux__)
+    rusage usage {};
+    getrusage(RUSAGE_THREAD, &usage);
+    return static_cast<std::uint64_t>(usage.ru_nivcsw);
+#else
+    return 0;
+#endif
+  }
+
+  std::uint64_t elapsed_ns(std::chrono::steady_clock::time_point since) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - since).count());
+  }
+
+  // A short critical section (one cache line of shared state) followed by a short
+  // stretch of private work, so that holders are regularly preempted mid-section
+  // once threads outnumber CPUs.
+  template <typename Mutex>
+  void oversubscribed(run_context& ctx) {
+    rmutex<std::array<std::uint64_t, 8>, Mutex> shared;
+    std::vector<worker_stats>                   stats(ctx.threads);
+    ctx.run_threads([&](unsigned index) {
+      worker_stats  local;
+      splitmix64    random(index + 1);
+      std::uint64_t overhead  = thread_cpu_clock_overhead();
+      std::uint64_t cpu_start = thread_cpu_ns();
+      std::uint64_t cs_start  = thread_involuntary_switches();
+      for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+        {
+          // Only contended acquisitions pay for the CPU clock readings.
+          auto data = shared.try_lock();
+          if (!data) {
+            std::uint64_t wait_start = thread_cpu_ns();
+            data.emplace(shared.lock());
+            std::uint64_t waited = thread_cpu_ns() - wait_start;
+            local.wait_cpu_ns += waited > overhead ? waited - overhead : 0;
+          }
+          auto held = std::chrono::steady_clock::now();
+          for (std::uint64_t& word : **data) {
+            word += i;
+          }
+          local.preempted_holds += elapsed_ns(held) > preemption_threshold_ns ? 1 : 0;
+        }
+        std::uint64_t work = random.next();
+        for (int step = 0; step < 32; ++step) {
+          work = work * 6364136223846793005ull + 1442695040888963407ull;
+        }
+        do_not_optimize(work);
+      }
+      local.total_cpu_ns   = thread_cpu_ns() - cpu_start;
+      local.involuntary_cs = thread_involuntary_switches() - cs_start;
+      stats[index]         = local;
+      return ctx.iterations;
+    });
+    worker_stats total;
+    for (const worker_stats& s : stats) {
+      total.preempted_holds += s.preempted_holds;
+      total.wait_cpu_ns += s.wait_cpu_ns;
+      total.total_cpu_ns += s.total_cpu_ns;
+      total.involuntary_cs += s.involuntary_cs;
+    }
+    double ops = static_cast<double>(ctx.operations);
+    ctx.metrics.emplace_back("preempted_holds_per_kop", static_cast<double>(total.preempted_holds) * 1000.0 / ops);
+    ctx.metrics.emplace_back("wait_cpu_ns_per_op", static_cast<double>(total.wait_cpu_ns) / ops);
+    ctx.metrics.emplace_back("wait_cpu_share",
+                             total.total_cpu_ns ? static_cast<double>(total.wait_cpu_ns) / static_cast<double>(total.total_cpu_ns) : 0.0);
+    ctx.metrics.emplace_back("invol_cs_per_kop", static_cast<double>(total.involuntary_cs) * 1000.0 / ops);
+  }
+
+  const registrar oversubscribed_std_mutex { "oversubscribed/std::mutex", &oversubscribed<std::mutex> };
+  const registrar oversubscribed_spin_mutex { "oversubscribed/spin_mutex", &oversubscribed<spin_mutex> };
+  const registrar oversubscribed_word_mutex { "oversubscribed/word_mutex", &oversubscribed<word_mutex> };
+}  // namespace
@@ -0,0 +1,194 @@
+/**
+ * @file perf_counters.hpp
+ * @brief Hardware and software performance counters for the rmutexpp benchmark harness.
+ *
+ * On Linux the counters are read through `perf_event_open`. Every counter is opened
+ * disabled and with `inherit` set, so the worker threads spawned by a benchmark are
+ * counted as well; their counts are folded back into the parent descriptor when they
+ * exit. Counters that cannot be opened (containers with a restrictive
+ * `perf_event_paranoid`, seccomp filters, virtual machines without a PMU, other
+ * operating systems) are simply reported as unavailable.
+ *
+ * Context switches fall back to `getrusage` when the software event is missing.
+ * Cache-line transfers (HITM) have no generic perf event; set `RMUTEX_BENCH_HITM_EVENT`
+ * to the raw event code of the current CPU model (e.g. `0x04d2` for
+ * MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM on Skylake) to enable them.
+ */
+#ifndef _RMUTEX_BENCH_PERF_COUNTERS_HEADER_
+#define _RMUTEX_BENCH_PERF_COUNTERS_HEADER_
+
+#include <array>    // For std::array
+#include <cstdint>  // For std::uint64_t
+#include <cstdlib>  // For std::getenv, std::strtoull
+#include <optional> // For std::optional
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace rmutexpp::bench {
+
+  /// @brief The events sampled around every benchmark run.
+  enum class counter : std::size_t { cycles, instructions, llc_misses, hitm, context_switches, count };
+
+  /// @brief Column names used by the reporters, indexed by `counter`.
+  inline constexpr std::array<const char*, static_cast<std::size_t>(counter::count)> counter_names {
+    "cycles", "instructions", "llc_misses", "hitm", "context_switches"
+  };
+
+  /**
+   * @struct counter_sample
+   * @brief The totals of one measured region; unavailable counters hold `std::nullopt`.
+   */
+  struct counter_sample {
+      std::array<std::optional<std::uint64_t>, static_cast<std::size_t>(counter::count)> values {};
+
+      std::optional<std::uint64_t>& operator[](counter c) { return values[static_cast<std::size_t>(c)]; }
+
+      const std::optional<std::uint64_t>& operator[](counter c) const { return values[static_cast<std::size_t>(c)]; }
+  };
+
+  /**
+   * @class perf_counters
+   * @brief Opens, starts, stops and reads the counters of `counter`.
+   *
+   * The object must be constructed before the worker threads of a run are created,
+   * otherwise `inherit` cannot attach the counters to them.
+   */
+  class perf_counters {
+#if defined(__linux__)
+      std::array<int, static_cast<std::size_t>(counter::count)> _fds;
+
+      static int open_event(std::uint32_t type, std::uint64_t config) {
+        perf_event_attr attr {};
+        attr.size           = sizeof(attr);
+        attr.type           = type;
+        attr.config         = config;
+        attr.disabled       = 1;
+        attr.inherit        = 1;
+        // Context switches are accounted in kernel mode; excluding it would count nothing.
+        attr.exclude_kernel = type == PERF_TYPE_SOFTWARE ? 0 : 1;
+        attr.exclude_hv     = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      }
+
+      int fd(counter c) const { return _fds[static_cast<std::size_t>(c)]; }
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+      std::uint64_t _rusage_switches = 0;
+
+      static std::uint64_t rusage_switches() {
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<std::uint64_t>(usage.ru_nvcsw) + static_cast<std::uint64_t>(usage.ru_nivcsw);
+      }
+#endif
+
+    public:
+      /**
+       * @brief Opens every counter that the kernel lets us open.
+       * @param enabled When false no counter is opened and every sample is empty.
+       */
+      explicit perf_counters(bool enabled = true) {
+#if defined(__linux__)
+        _fds.fill(-1);
+        if (!enabled) {
+          return;
+        }
+        _fds[static_cast<std::size_t>(counter::cycles)]       = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        _fds[static_cast<std::size_t>(counter::instructions)] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        _fds[static_cast<std::size_t>(counter::llc_misses)]   = open_event(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL |
+                                                                                                   (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                                                                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        if (fd(counter::llc_misses) < 0) {
+          _fds[static_cast<std::size_t>(counter::llc_misses)] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        }
+        if (const char* raw = std::getenv("RMUTEX_BENCH_HITM_EVENT")) {
+          _fds[static_cast<std::size_t>(counter::hitm)] = open_event(PERF_TYPE_RAW, std::strtoull(raw, nullptr, 0));
+        }
+        _fds[static_cast<std::size_t>(counter::context_switches)] = open_event(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES);
+#else
+        (void)enabled;
+#endif
+      }
+
+      ~perf_counters() {
+#if defined(__linux__)
+        for (int descriptor : _fds) {
+          if (descriptor >= 0) {
+            close(descriptor);
+          }
+        }
+#endif
+      }
+
+      perf_counters(const perf_counters&)            = delete;
+      perf_counters& operator=(const perf_counters&) = delete;
+
+      /**
+       * @brief Checks whether a counter was opened successfully.
+       * @param c The counter to check.
+       * @return True if `c` is read through `perf_event_open`.
+       */
+      bool available(counter c) const noexcept {
+#if defined(__linux__)
+        return fd(c) >= 0;
+#else
+        (void)c;
+        return false;
+#endif
+      }
+
+      /// @brief Resets and enables all open counters.
+      void start() {
+#if defined(__linux__)
+        for (int descriptor : _fds) {
+          if (descriptor >= 0) {
+            ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+            ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+          }
+        }
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+        _rusage_switches = rusage_switches();
+#endif
+      }
+
+      /**
+       * @brief Disables all open counters and reads their totals.
+       *
+       * Inherited counts are only folded back once the worker threads have exited,
+       * so call this after joining them.
+       *
+       * @return The totals since the last `start()`.
+       */
+      counter_sample stop() {
+        counter_sample sample;
+#if defined(__linux__)
+        for (std::size_t i = 0; i < _fds.size(); ++i) {
+          if (_fds[i] < 0) {
+            continue;
+          }
+          ioctl(_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+          std::uint64_t value = 0;
+          if (read(_fds[i], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+            sample.values[i] = value;
+          }
+        }
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+        if (!sample[counter::context_switches]) {
+          sample[counter::context_switches] = rusage_switches() - _rusage_switches;
+        }
+#endif
+        return sample;
+      }
+  };
+}  // namespace rmutexpp::bench
+#endif  // _RMUTEX_BENCH_PERF_COUNTERS_HEADER_
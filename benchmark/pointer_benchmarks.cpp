@@ -0,0 +1,54 @@
+// rmutexpp/benchmark/pointer_benchmarks.cpp
+//
+// A hash-bucket array of 2^20 locked head pointers. Every operation locks a random
+// bucket and swaps its head pointer:
+//
+//   pointer/buckets/rmutex          rmutex<node*> (std::mutex next to the pointer, 48 bytes)
+//   pointer/buckets/pointer_rmutex  pointer_rmutex<node*> (lock bits inside the pointer, 8 bytes)
+
+#include <cstdint>  // For std::uint64_t
+#include <memory>   // For std::unique_ptr
+
+#include "bench_harness.hpp"
+#include "rmutexpp/pointer_rmutex.hpp"
+#include "rmutexpp/rmutex.hpp"
+#include "zipfian.hpp"
+
+using namespace rmutexpp;
+using namespace rmutexpp::bench;
+
+namespace {
+  constexpr std::size_t bucket_count = std::size_t { 1 } << 20;
+
+  struct node {
+      std::uint64_t value;
+  };
+
+  node sentinels[2];
+}  // namespace
+
+RMUTEX_BENCHMARK("pointer/buckets/rmutex") {
+  std::unique_ptr<rmutex<node*>[]> buckets(new rmutex<node*>[bucket_count]);
+  ctx.metrics.emplace_back("bytes_per_bucket", static_cast<double>(sizeof(rmutex<node*>)));
+  ctx.run_threads([&](unsigned index) {
+    splitmix64 random(index + 1);
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      rmutex_ref head = buckets[random.next() % bucket_count].lock();
+      *head           = *head == &sentinels[0] ? &sentinels[1] : &sentinels[0];
+    }
+    return ctx.iterations;
+  });
+}
+
+RMUTEX_BENCHMARK("pointer/buckets/pointer_rmutex") {
+  std::unique_ptr<pointer_rmutex<node*>[]> buckets(new pointer_rmutex<node*>[bucket_count]);
+  ctx.metrics.emplace_back("bytes_per_bucket", static_cast<double>(sizeof(pointer_rmutex<node*>)));
+  ctx.run_threads([&](unsigned index) {
+    splitmix64 random(index + 1);
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      auto head = buckets[random.next() % bucket_count].lock();
+      head.set(head.get() == &sentinels[0] ? &sentinels[1] : &sentinels[0]);
+    }
+    return ctx.iterations;
+  });
+}
@@ -0,0 +1,67 @@
+// rmutexpp/benchmark/range_benchmarks.cpp
+//
+// Writers updating disjoint index ranges of one large vector, protected either by a
+// single rmutex<std::vector> or by range_rmutex<std::vector>. Every operation locks a
+// `range_width`-element range at a random offset inside the calling thread's stripe,
+// so with range_rmutex no two writers ever conflict and the remaining cost is the
+// range bookkeeping itself. Stripes are at least one range wide, so threads beyond
+// `max_writers` stay idle instead of sharing (or overrunning) a stripe.
+
+#include <cstdint>  // For std::uint64_t
+#include <vector>   // For std::vector
+
+#include "bench_harness.hpp"
+#include "rmutexpp/range_rmutex.hpp"
+#include "rmutexpp/rmutex.hpp"
+#include "zipfian.hpp"
+
+using namespace rmutexpp;
+using namespace rmutexpp::bench;
+
+namespace {
+  constexpr std::size_t range_elements = std::size_t { 1 } << 16;
+  constexpr std::size_t range_width    = 64;
+  constexpr unsigned    max_writers    = range_elements / range_width;
+
+  // Start of a random range inside the stripe owned by thread `index`, one of `min(threads, max_writers)` stripes.
+  std::size_t stripe_offset(splitmix64& random, unsigned index, unsigned threads) {
+    std::size_t stripe = range_elements / (threads < max_writers ? threads : max_writers);
+    return index * stripe + random.next() % (stripe - range_width + 1);
+  }
+}  // namespace
+
+RMUTEX_BENCHMARK("range/disjoint_writers/rmutex") {
+  rmutex<std::vector<std::uint64_t>> values(range_elements, std::uint64_t { 0 });
+  ctx.run_threads([&](unsigned index) {
+    if (index >= max_writers) {
+      return std::uint64_t { 0 };
+    }
+    splitmix64 random(index + 1);
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      std::size_t begin = stripe_offset(random, index, ctx.threads);
+      rmutex_ref  data  = values.lock();
+      for (std::size_t k = begin; k < begin + range_width; ++k) {
+        ++(*data)[k];
+      }
+    }
+    return ctx.iterations;
+  });
+}
+
+RMUTEX_BENCHMARK("range/disjoint_writers/range_rmutex") {
+  range_rmutex<std::vector<std::uint64_t>> values(range_elements, std::uint64_t { 0 });
+  ctx.run_threads([&](unsigned index) {
+    if (index >= max_writers) {
+      return std::uint64_t { 0 };
+    }
+    splitmix64 random(index + 1);
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      std::size_t begin = stripe_offset(random, index, ctx.threads);
+      auto        slice = values.lock(begin, begin + range_width);
+      for (std::uint64_t& value : slice) {
+        ++value;
+      }
+    }
+    return ctx.iterations;
+  });
+}
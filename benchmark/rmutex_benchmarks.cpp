@@ -0,0 +1,188 @@
+// rmutexpp/benchmark/rmutex_benchmarks.cpp
+//
+// Lock/unlock microbenchmarks for rmutex, rmutex_ref and rmutex_guard.
+
+#include <cstdint>  // For std::uint64_t
+#include <memory>   // For std::unique_ptr
+#include <mutex>    // For std::recursive_mutex
+#include <vector>   // For std::vector
+
+#include "bench_harness.hpp"
+#include "rmutexpp/rmutex.hpp"
+#include "rmutexpp/rmutex_backends.hpp"
+#include "rmutexpp/rmutex_guard.hpp"
+#include "rmutexpp/single_threaded.hpp"
+
+using namespace rmutexpp;
+using namespace rmutexpp::bench;
+
+namespace {
+  // Keeps per-thread mutexes on separate cache lines so "uncontended" measures the lock alone.
+  struct alignas(64) padded_counter {
+      rmutex<std::uint64_t> value { 0 };
+  };
+
+  // An outer lock that stays held while a callback re-enters the same rmutex.
+  template <typename Mutex>
+  void recursive_run(run_context& ctx) {
+    rmutex<std::uint64_t, Mutex> mutex { 0 };
+    ctx.run_threads([&](unsigned index) {
+      if (index != 0) {
+        return std::uint64_t { 0 };
+      }
+      rmutex_ref outer = mutex.lock();
+      for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+        ++*mutex.lock();
+      }
+      return ctx.iterations;
+    });
+  }
+}  // namespace
+
+// Every thread locks its own rmutex: the cost of an uncontended acquisition.
+RMUTEX_BENCHMARK("rmutex/uncontended") {
+  std::unique_ptr<padded_counter[]> counters(new padded_counter[ctx.threads]);
+  ctx.run_threads([&](unsigned index) {
+    rmutex<std::uint64_t>& mutex = counters[index].value;
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      rmutex_ref ref = mutex.lock();
+      ++*ref;
+    }
+    return ctx.iterations;
+  });
+}
+
+// The same uncontended increment through with_lock: no rmutex_ref, no owns flag.
+RMUTEX_BENCHMARK("rmutex/uncontended_with_lock") {
+  std::unique_ptr<padded_counter[]> counters(new padded_counter[ctx.threads]);
+  ctx.run_threads([&](unsigned index) {
+    rmutex<std::uint64_t>& mutex = counters[index].value;
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      mutex.with_lock([](std::uint64_t& value) { ++value; });
+    }
+    return ctx.iterations;
+  });
+}
+
+namespace {
+  // An uncontended word_mutex on one thread, with and without single-threaded mode. The
+  // other threads sit the run out: the mode is only sound while a single thread locks.
+  template <bool Elided>
+  std::uint64_t single_threaded_run(unsigned index, std::uint64_t iterations) {
+    if (index != 0) {
+      return 0;
+    }
+    rmutex<std::uint64_t, word_mutex> mutex { 0 };
+    if constexpr (Elided) {
+      enter_single_threaded_mode();
+    }
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+      ++*mutex.lock();
+    }
+    leave_single_threaded_mode();
+    do_not_optimize(*mutex.lock());
+    return iterations;
+  }
+}  // namespace
+
+RMUTEX_BENCHMARK("single_threaded/atomic") {
+  ctx.run_threads([&](unsigned index) { return single_threaded_run<false>(index, ctx.iterations); });
+}
+
+RMUTEX_BENCHMARK("single_threaded/elided") {
+  ctx.run_threads([&](unsigned index) { return single_threaded_run<true>(index, ctx.iterations); });
+}
+
+// Every thread reads one shared value built once: under the lock, then frozen with no lock.
+RMUTEX_BENCHMARK("read/locked") {
+  rmutex<std::uint64_t, freezable_mutex<>> shared { 42 };
+  ctx.run_threads([&](unsigned) {
+    std::uint64_t sum = 0;
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      sum += *shared.lock();
+    }
+    do_not_optimize(sum);
+    return ctx.iterations;
+  });
+}
+
+RMUTEX_BENCHMARK("read/frozen") {
+  rmutex<std::uint64_t, freezable_mutex<>> shared { 42 };
+  shared.freeze();
+  ctx.run_threads([&](unsigned) {
+    std::uint64_t sum = 0;
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      const std::uint64_t& value = shared.read();
+      do_not_optimize(value);
+      sum += value;
+    }
+    do_not_optimize(sum);
+    return ctx.iterations;
+  });
+}
+
+RMUTEX_BENCHMARK("recursive/std_recursive_mutex") { recursive_run<std::recursive_mutex>(ctx); }
+
+RMUTEX_BENCHMARK("recursive/recursive_word_mutex") { recursive_run<recursive_word_mutex>(ctx); }
+
+// All threads fight over a single rmutex with an empty critical section.
+RMUTEX_BENCHMARK("rmutex/contended") {
+  rmutex<std::uint64_t> shared { 0 };
+  ctx.run_threads([&](unsigned) {
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      rmutex_ref ref = shared.lock();
+      ++*ref;
+    }
+    return ctx.iterations;
+  });
+}
+
+// try_lock on a shared rmutex; only successful attempts count as acquisitions.
+RMUTEX_BENCHMARK("rmutex/try_lock") {
+  rmutex<std::uint64_t> shared { 0 };
+  ctx.run_threads([&](unsigned) {
+    std::uint64_t acquired = 0;
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      if (auto ref = shared.try_lock()) {
+        ++**ref;
+        ++acquired;
+      }
+    }
+    return acquired;
+  });
+}
+
+// A longer critical section: the lock holder touches a 1 KiB buffer.
+RMUTEX_BENCHMARK("rmutex/contended_1k_section") {
+  rmutex<std::vector<std::uint64_t>> shared { 128, std::uint64_t { 0 } };
+  ctx.run_threads([&](unsigned) {
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      rmutex_ref ref = shared.lock();
+      for (std::uint64_t& word : *ref) {
+        ++word;
+      }
+    }
+    return ctx.iterations;
+  });
+}
+
+// Two shared rmutexes locked together through rmutex_guard, in alternating order.
+RMUTEX_BENCHMARK("rmutex_guard/pair") {
+  rmutex<std::uint64_t> first { 0 }, second { 0 };
+  ctx.run_threads([&](unsigned index) {
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      if (index % 2 == 0) {
+        rmutex_guard guard { first, second };
+        auto [a, b] = *guard.get_data();
+        ++a;
+        ++b;
+      } else {
+        rmutex_guard guard { second, first };
+        auto [b, a] = *guard.get_data();
+        ++a;
+        ++b;
+      }
+    }
+    return ctx.iterations;
+  });
+}
@@ -0,0 +1,175 @@
+// rmutexpp/benchmark/scenario_benchmarks.cpp
+//
+// Macro-workload scenarios shaped like the ways rmutex is used in practice. Keys are
+// drawn from a Zipf distribution (--skew, --keys) so hot spots can be dialled in, and
+// every scenario reports time per *operation* (a transfer, a queue operation, a
+// lookup, a cache access) rather than per raw lock acquisition.
+
+#include <cstdint>        // For std::uint64_t
+#include <deque>          // For std::deque
+#include <list>           // For std::list
+#include <string>         // For std::string, std::to_string
+#include <unordered_map>  // For std::unordered_map
+#include <utility>        // For std::pair
+#include <vector>         // For std::vector
+
+#include "bench_harness.hpp"
+#include "rmutexpp/rmutex.hpp"
+#include "rmutexpp/rmutex_guard.hpp"
+#include "zipfian.hpp"
+
+using namespace rmutexpp;
+using namespace rmutexpp::bench;
+
+namespace {
+  struct account {
+      std::int64_t  balance   = 1000;
+      std::uint64_t transfers = 0;
+  };
+
+  // A small LRU cache of the kind usually wrapped in a single rmutex.
+  class lru_cache {
+      using entry = std::pair<std::uint64_t, std::string>;
+
+      std::size_t                                                     _capacity;
+      std::list<entry>                                                _order;
+      std::unordered_map<std::uint64_t, std::list<entry>::iterator> _index;
+
+    public:
+      explicit lru_cache(std::size_t capacity): _capacity(capacity < 1 ? 1 : capacity) { _index.reserve(_capacity); }
+
+      // Returns true on a hit; on a miss the value is inserted, evicting the least recently used entry.
+      bool access(std::uint64_t key) {
+        auto found = _index.find(key);
+        if (found != _index.end()) {
+          _order.splice(_order.begin(), _order, found->second);
+          return true;
+        }
+        if (_order.size() == _capacity) {
+          _index.erase(_order.back().first);
+          _order.pop_back();
+        }
+        _order.emplace_front(key, std::to_string(key));
+        _index.emplace(key, _order.begin());
+        return false;
+      }
+  };
+
+  constexpr std::size_t   queue_shards        = 8;
+  constexpr std::size_t   queue_capacity      = 4096;
+  constexpr std::uint64_t config_write_period = 20;  // One write every 20 operations: 95% reads.
+}  // namespace
+
+// Bank transfers between `keys` accounts: every operation locks two accounts with
+// rmutex_guard and moves money between them. Skew concentrates transfers on a few
+// hot accounts, which is where multi-lock acquisition order starts to matter.
+RMUTEX_BENCHMARK("scenario/bank_transfer") {
+  std::vector<rmutex<account>> accounts(ctx.keys);
+  zipfian                      pick(ctx.keys, ctx.skew);
+  ctx.run_threads([&](unsigned index) {
+    splitmix64 random(index + 1);
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      std::uint64_t from = pick(random);
+      std::uint64_t to   = pick(random);
+      if (from == to) {
+        to = (to + 1) % accounts.size();
+      }
+      rmutex_guard guard { accounts[from], accounts[to] };
+      auto [source, target] = *guard.get_data();
+      std::int64_t amount   = static_cast<std::int64_t>(random.next() % 16);
+      source.balance -= amount;
+      target.balance += amount;
+      ++source.transfers;
+    }
+    return ctx.iterations;
+  });
+  std::int64_t total = 0;
+  for (rmutex<account>& acc : accounts) {
+    total += acc.lock()->balance;
+  }
+  ctx.metrics.emplace_back("balance_ok", total == static_cast<std::int64_t>(ctx.keys) * 1000 ? 1.0 : 0.0);
+}
+
+// Producer-consumer on sharded rmutex<std::deque>: even workers produce, odd workers
+// consume, and the shard of every operation is Zipf-distributed so skew creates a
+// hot queue. A single worker alternates between both roles.
+RMUTEX_BENCHMARK("scenario/producer_consumer") {
+  std::vector<rmutex<std::deque<std::uint64_t>>> queues(queue_shards);
+  zipfian                                        pick(queue_shards, ctx.skew);
+  std::vector<std::uint64_t>                     consumed(ctx.threads, 0);
+  ctx.run_threads([&](unsigned index) {
+    splitmix64    random(index + 1);
+    std::uint64_t pops = 0;
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      bool       produce = ctx.threads == 1 ? (i % 2 == 0) : (index % 2 == 0);
+      rmutex_ref queue   = queues[pick(random)].lock();
+      if (produce) {
+        if (queue->size() < queue_capacity) {
+          queue->push_back(i);
+        }
+      } else if (!queue->empty()) {
+        queue->pop_front();
+        ++pops;
+      }
+    }
+    consumed[index] = pops;
+    return ctx.iterations;
+  });
+  std::uint64_t pops = 0;
+  for (std::uint64_t count : consumed) {
+    pops += count;
+  }
+  ctx.metrics.emplace_back("pop_ratio", static_cast<double>(pops) / static_cast<double>(ctx.operations));
+}
+
+// Read-mostly configuration lookup: 95% of operations look up a Zipf-distributed key
+// in rmutex<std::unordered_map<std::string, std::string>>, 5% overwrite a value.
+RMUTEX_BENCHMARK("scenario/read_mostly_config") {
+  std::vector<std::string>                               names;
+  rmutex<std::unordered_map<std::string, std::string>> config;
+  {
+    rmutex_ref map = config.lock();
+    for (std::uint64_t key = 0; key < ctx.keys; ++key) {
+      names.push_back("config.section" + std::to_string(key % 17) + ".key" + std::to_string(key));
+      map->emplace(names.back(), "value-" + std::to_string(key));
+    }
+  }
+  zipfian pick(ctx.keys, ctx.skew);
+  ctx.run_threads([&](unsigned index) {
+    splitmix64  random(index + 1);
+    std::size_t checksum = 0;
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      const std::string& name = names[pick(random)];
+      rmutex_ref         map  = config.lock();
+      if (i % config_write_period == 0) {
+        (*map)[name] = "updated-" + std::to_string(i);
+      } else {
+        checksum += map->find(name)->second.size();
+      }
+    }
+    do_not_optimize(checksum);
+    return ctx.iterations;
+  });
+}
+
+// LRU cache holding a quarter of the key space behind one rmutex; skew decides the hit rate.
+RMUTEX_BENCHMARK("scenario/lru_cache") {
+  rmutex<lru_cache>          cache { ctx.keys / 4 };
+  zipfian                    pick(ctx.keys, ctx.skew);
+  std::vector<std::uint64_t> hits(ctx.threads, 0);
+  ctx.run_threads([&](unsigned index) {
+    splitmix64    random(index + 1);
+    std::uint64_t hit = 0;
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      std::uint64_t key = pick(random);
+      hit += cache.lock()->access(key) ? 1 : 0;
+    }
+    hits[index] = hit;
+    return ctx.iterations;
+  });
+  std::uint64_t total = 0;
+  for (std::uint64_t count : hits) {
+    total += count;
+  }
+  ctx.metrics.emplace_back("hit_rate", static_cast<double>(total) / static_cast<double>(ctx.operations));
+}
@@ -0,0 +1,62 @@
+// rmutexpp/benchmark/shared_benchmarks.cpp
+//
+// Reference-counted rmutex handles:
+//
+//   shared/make_lock/shared_ptr     std::make_shared<rmutex<T>>, lock once, drop
+//   shared/make_lock/shared_rmutex  make_shared_rmutex<T>, lock once, drop
+//   shared/clone/shared_ptr         copy and drop a std::shared_ptr<rmutex<T>>
+//   shared/clone/shared_rmutex      copy and drop a shared_rmutex<T>
+//
+// The clone benchmarks share one handle between all threads, so their counts contend.
+
+#include <cstdint>  // For std::uint64_t
+#include <memory>   // For std::shared_ptr, std::make_shared
+
+#include "bench_harness.hpp"
+#include "rmutexpp/rmutex.hpp"
+#include "rmutexpp/shared_rmutex.hpp"
+
+using namespace rmutexpp;
+using namespace rmutexpp::bench;
+
+RMUTEX_BENCHMARK("shared/make_lock/shared_ptr") {
+  ctx.run_threads([&](unsigned) {
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      std::shared_ptr<rmutex<std::uint64_t>> counter = std::make_shared<rmutex<std::uint64_t>>(i);
+      do_not_optimize(++*counter->lock());
+    }
+    return ctx.iterations;
+  });
+}
+
+RMUTEX_BENCHMARK("shared/make_lock/shared_rmutex") {
+  ctx.run_threads([&](unsigned) {
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      shared_rmutex<std::uint64_t> counter = make_shared_rmutex<std::uint64_t>(i);
+      do_not_optimize(++*counter.lock());
+    }
+    return ctx.iterations;
+  });
+}
+
+RMUTEX_BENCHMARK("shared/clone/shared_ptr") {
+  std::shared_ptr<rmutex<std::uint64_t>> source = std::make_shared<rmutex<std::uint64_t>>(0);
+  ctx.run_threads([&](unsigned) {
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      std::shared_ptr<rmutex<std::uint64_t>> copy = source;
+      do_not_optimize(copy);
+    }
+    return ctx.iterations;
+  });
+}
+
+RMUTEX_BENCHMARK("shared/clone/shared_rmutex") {
+  shared_rmutex<std::uint64_t> source = make_shared_rmutex<std::uint64_t>(0);
+  ctx.run_threads([&](unsigned) {
+    for (std::uint64_t i = 0; i < ctx.iterations; ++i) {
+      shared_rmutex<std::uint64_t> copy = source;
+      do_not_optimize(copy);
+    }
+    return ctx.iterations;
+  });
+}
@@ -0,0 +1,104 @@
+// rmutexpp/benchmark/soa_benchmarks.cpp
+//
+// 2^14 locked 256-byte records, stored either as std::vector<rmutex<record>> (each
+// std::mutex next to its record) or as rmutex_array<record> (a dense word_mutex array
+// plus a contiguous record array). Every operation is one element of a full pass:
+//
+//   soa/busy_scan/{vector_of_rmutex,rmutex_array}  try-lock and release every element while
+//                                                  one in 64 is held elsewhere
+//   soa/sum/{vector_of_rmutex,rmutex_array}        sum one field of every record: a lock
+//                                                  per element, or lock_all() and one span
+
+#include <array>    // For std::array
+#include <cstdint>  // For std::uint64_t
+#include <vector>   // For std::vector
+
+#include "bench_harness.hpp"
+#include "rmutexpp/rmutex.hpp"
+#include "rmutexpp/rmutex_array.hpp"
+
+using namespace rmutexpp;
+using namespace rmutexpp::bench;
+
+namespace {
+  constexpr std::size_t record_count = std::size_t { 1 } << 14;
+  constexpr std::size_t held_stride  = 64;
+
+  struct record {
+      std::uint64_t                 hits = 0;
+      std::array<std::uint64_t, 31> payload {};
+  };
+}  // namespace
+
+RMUTEX_BENCHMARK("soa/busy_scan/vector_of_rmutex") {
+  std::vector<rmutex<record>>     records(record_count);
+  std::vector<rmutex_ref<record>> held;
+  for (std::size_t i = 0; i < record_count; i += held_stride) {
+    held.push_back(records[i].lock());
+  }
+  ctx.run_threads([&](unsigned) {
+    std::uint64_t passes = ctx.iterations / record_count + 1;
+    std::uint64_t free   = 0;
+    for (std::uint64_t pass = 0; pass < passes; ++pass) {
+      for (rmutex<record>& element : records) {
+        if (auto data = element.try_lock()) {
+          ++free;
+        }
+      }
+    }
+    do_not_optimize(free);
+    return passes * record_count;
+  });
+}
+
+RMUTEX_BENCHMARK("soa/busy_scan/rmutex_array") {
+  rmutex_array<record>                              records(record_count);
+  std::vector<rmutex_array_ref<record, word_mutex>> held;
+  for (std::size_t i = 0; i < record_count; i += held_stride) {
+    held.push_back(records.lock(i));
+  }
+  ctx.run_threads([&](unsigned) {
+    std::uint64_t passes = ctx.iterations / record_count + 1;
+    std::uint64_t free   = 0;
+    for (std::uint64_t pass = 0; pass < passes; ++pass) {
+      for (std::size_t index = 0; index < record_count; ++index) {
+        if (auto data = records.try_lock(index)) {
+          ++free;
+        }
+      }
+    }
+    do_not_optimize(free);
+    return passes * record_count;
+  });
+}
+
+RMUTEX_BENCHMARK("soa/sum/vector_of_rmutex") {
+  std::vector<rmutex<record>> records(record_count);
+  ctx.run_threads([&](unsigned) {
+    std::uint64_t passes = ctx.iterations / record_count + 1;
+    std::uint64_t sum    = 0;
+    for (std::uint64_t pass = 0; pass < passes; ++pass) {
+      for (rmutex<record>& element : records) {
+        sum += element.lock()->hits;
+      }
+    }
+    do_not_optimize(sum);
+    return passes * record_count;
+  });
+}
+
+RMUTEX_BENCHMARK("soa/sum/rmutex_array") {
+  rmutex_array<record> records(record_count);
+  ctx.run_threads([&](unsigned) {
+    std::uint64_t passes = ctx.iterations / record_count + 1;
+    std::uint64_t sum    = 0;
+    for (std::uint64_t pass = 0; pass < passes; ++pass) {
+      auto all = records.lock_all();
+      for (const record& element : all.span()) {
+        sum += element.hits;
+      }
+    }
+    do_not_optimize(sum);
+    return passes * record_count;
+  });
+}
@@ -0,0 +1,90 @@
+/**
+ * @file zipfian.hpp
+ * @brief Zipfian key generator for the rmutexpp scenario benchmarks.
+ *
+ * Implements the rejection-free generator of Gray et al. ("Quickly Generating
+ * Billion-Record Synthetic Databases"), as popularized by YCSB. Key `0` is the most
+ * popular one; `theta = 0` degenerates to a uniform distribution and values close
+ * to 1 concentrate most accesses on a handful of keys.
+ */
+#ifndef _RMUTEX_BENCH_ZIPFIAN_HEADER_
+#define _RMUTEX_BENCH_ZIPFIAN_HEADER_
+
+#include <cmath>    // For std::pow
+#include <cstdint>  // For std::uint64_t
+
+namespace rmutexpp::bench {
+
+  /**
+   * @class splitmix64
+   * @brief A tiny, fast PRNG; one instance per worker thread.
+   */
+  class splitmix64 {
+      std::uint64_t _state;
+
+    public:
+      explicit splitmix64(std::uint64_t seed): _state(seed) { }
+
+      std::uint64_t next() {
+        std::uint64_t z = (_state += 0x9e3779b97f4a7c15ull);
+        z               = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z               = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+      }
+
+      /// @brief A uniform double in [0, 1).
+      double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+  };
+
+  /**
+   * @class zipfian
+   * @brief Draws keys in [0, n) following a Zipf distribution with exponent `theta`.
+   *
+   * Construction is O(n) (it computes the generalized harmonic number), so build one
+   * generator per benchmark run and share it read-only between the workers.
+   */
+  class zipfian {
+      std::uint64_t _n;
+      double        _theta;
+      double        _alpha;
+      double        _zetan;
+      double        _eta;
+
+      static double zeta(std::uint64_t n, double theta) {
+        double sum = 0;
+        for (std::uint64_t i = 1; i <= n; ++i) {
+          sum += 1.0 / std::pow(static_cast<double>(i), theta);
+        }
+        return sum;
+      }
+
+    public:
+      /**
+       * @param n Number of distinct keys, at least 1.
+       * @param theta Skew in [0, 1); 0.99 is the classic YCSB setting.
+       */
+      zipfian(std::uint64_t n, double theta): _n(n < 1 ? 1 : n), _theta(theta < 0 ? 0 : (theta >= 1 ? 0.999 : theta)) {
+        double zeta2 = zeta(2, _theta);
+        _alpha       = 1.0 / (1.0 - _theta);
+        _zetan       = zeta(_n, _theta);
+        _eta         = (1.0 - std::pow(2.0 / static_cast<double>(_n), 1.0 - _theta)) / (1.0 - zeta2 / _zetan);
+      }
+
+      /// @brief Draws the next key using the caller's random source.
+      std::uint64_t operator()(splitmix64& random) const {
+        double u  = random.uniform();
+        double uz = u * _zetan;
+        if (uz < 1.0) {
+          return 0;
+        }
+        if (uz < 1.0 + std::pow(0.5, _theta)) {
+          return _n > 1 ? 1 : 0;
+        }
+        auto key = static_cast<std::uint64_t>(static_cast<double>(_n) * std::pow(_eta * u - _eta + 1.0, _alpha));
+        return key < _n ? key : _n - 1;
+      }
+
+      std::uint64_t size() const noexcept { return _n; }
+  };
+}  // namespace rmutexpp::bench
+#endif  // _RMUTEX_BENCH_ZIPFIAN_HEADER_
@@ -0,0 +1,306 @@
+/**
+ * @file chunked_iteration.hpp
+ * @brief Defines for_each_chunked and chunked_scan, incremental iteration over the
+ * container inside an rmutex that releases the lock between chunks.
+ *
+ * A full scan of a large `rmutex<std::unordered_map<...>>` under one lock stalls every
+ * writer for the whole scan. A chunked scan instead locks, visits about `chunk_size`
+ * elements, remembers a cursor that stays meaningful while the lock is released, and
+ * unlocks so waiting writers get in before the next chunk.
+ *
+ * Cursors depend on the container:
+ *
+ * | container                          | cursor          | structural version         |
+ * |------------------------------------|-----------------|----------------------------|
+ * | unordered (`bucket_count()`)       | bucket index    | `bucket_count()`           |
+ * | ordered (`upper_bound()`)          | last key seen   | none needed                |
+ * | random access (`vector`, `deque`)  | element index   | `size()`                   |
+ * | `versioned<C>`                     | that of `C`     | bumped by every `modify()` |
+ *
+ * When the structural version changed between two chunks, the cursor may no longer
+ * designate the same position, and the chosen `chunk_policy` decides what happens next.
+ *
+ * Standard containers carry no modification counter, so the version is only a proxy
+ * and some changes go undetected:
+ * - sequences: insertions and erasures that leave the size unchanged (one insert and
+ *   one erase between two chunks) shift elements across the cursor unnoticed, so
+ *   elements can be visited twice or missed even under `chunk_policy::restart`;
+ * - unordered containers: a rehash that ends on the bucket count it started from.
+ *   Insertions and erasures without a rehash need no detection: elements stay in
+ *   their bucket.
+ *
+ * Wrap the container in `versioned` when a scan must see every structural change.
+ */
+#ifndef _CHUNKED_ITERATION_HEADER_
+#define _CHUNKED_ITERATION_HEADER_
+
+#include <cstddef>      // For std::size_t
+#include <functional>   // For std::invoke
+#include <iterator>     // For std::prev
+#include <optional>     // For std::optional
+#include <ranges>       // For std::ranges::random_access_range, std::ranges::size
+#include <thread>       // For std::this_thread::yield
+#include <utility>      // For std::move
+
+#include "rmutex.hpp"  // For rmutex, rmutex_ref
+
+namespace rmutexpp {
+
+  /**
+   * @enum chunk_policy
+   * @brief What a chunked scan does when the container changed structurally between chunks.
+   */
+  enum class chunk_policy {
+    restart,  ///< Start over from the beginning: every element present for the whole scan is visited, some maybe twice.
+    skip      ///< Carry on from a nearby position: best-effort, elements may be visited twice or missed after a change.
+  };
+
+  /**
+   * @struct chunked_stats
+   * @brief Counters of one chunked scan.
+   */
+  struct chunked_stats {
+      std::size_t visited            = 0;  ///< Elements passed to the callback.
+      std::size_t chunks             = 0;  ///< Lock acquisitions.
+      std::size_t structural_changes = 0;  ///< Chunks that found the structural version changed.
+  };
+
+  namespace detail {
+    template <typename C>
+    concept bucketed_container = requires(C& c, std::size_t n) {
+      c.bucket_count();
+      c.begin(n);
+      c.end(n);
+    };
+
+    template <typename C>
+    concept ordered_container = requires(C& c, const typename C::key_type& key) { c.upper_bound(key); };
+
+    template <typename C>
+    struct chunk_cursor {
+        static_assert(sizeof(C) == 0, "for_each_chunked needs an unordered, ordered or random-access container.");
+    };
+
+    // Unordered containers: whole buckets are visited, the cursor is the next bucket.
+    template <bucketed_container C>
+    struct chunk_cursor<C> {
+        std::size_t next_bucket = 0;
+        std::size_t buckets     = 0;  ///< The bucket count the cursor was computed for.
+        std::size_t version     = 0;
+
+        static std::size_t version_of(const C& c) noexcept { return c.bucket_count(); }
+
+        void restart(const C&) noexcept { next_bucket = 0; }
+
+        // Maps the position onto the new bucket array proportionally; elements move between
+        // buckets in a rehash, so this is only an approximation of the old position.
+        void rebase(const C& c) noexcept { next_bucket = buckets ? next_bucket * c.bucket_count() / buckets : 0; }
+
+        template <typename Fn>
+        bool step(C& c, std::size_t chunk_size, Fn& fn, chunked_stats& stats) {
+          buckets             = c.bucket_count();
+          std::size_t visited = 0;
+          for (; next_bucket < c.bucket_count() && visited < chunk_size; ++next_bucket) {
+            for (auto it = c.begin(next_bucket); it != c.end(next_bucket); ++it, ++visited) {
+              std::invoke(fn, *it);
+            }
+          }
+          stats.visited += visited;
+          return next_bucket >= c.bucket_count();
+        }
+    };
+
+    // Ordered containers: the cursor is the last key visited, which stays valid across any change.
+    template <ordered_container C>
+      requires(!bucketed_container<C>)
+    struct chunk_cursor<C> {
+        std::optional<typename C::key_type> last;
+        std::size_t                         version = 0;
+
+        static std::size_t version_of(const C&) noexcept { return 0; }
+
+        void restart(const C&) { last.reset(); }
+
+        void rebase(const C&) noexcept { }
+
+        template <typename Fn>
+        bool step(C& c, std::size_t chunk_size, Fn& fn, chunked_stats& stats) {
+          auto        it      = last ? c.upper_bound(*last) : c.begin();
+          std::size_t visited = 0;
+          for (; it != c.end() && visited < chunk_size; ++it, ++visited) {
+            std::invoke(fn, *it);
+          }
+          if (visited) {
+            if constexpr (requires { typename C::mapped_type; }) {
+              last = std::prev(it)->first;
+            } else {
+              last = *std::prev(it);
+            }
+          }
+          stats.visited += visited;
+          return it == c.end();
+        }
+    };
+
+    // Random-access sequences: the cursor is the next index.
+    template <typename C>
+      requires(!bucketed_container<C> && !ordered_container<C> && std::ranges::random_access_range<C> && std::ranges::sized_range<C>)
+    struct chunk_cursor<C> {
+        std::size_t next    = 0;
+        std::size_t version = 0;
+
+        static std::size_t version_of(const C& c) noexcept { return std::ranges::size(c); }
+
+        void restart(const C&) noexcept { next = 0; }
+
+        void rebase(const C& c) noexcept { next = next < std::ranges::size(c) ? next : std::ranges::size(c); }
+
+        template <typename Fn>
+        bool step(C& c, std::size_t chunk_size, Fn& fn, chunked_stats& stats) {
+          std::size_t size = std::ranges::size(c);
+          std::size_t start = next;
+          std::size_t end   = size - next > chunk_size ? next + chunk_size : size;
+          for (auto it = std::ranges::begin(c) + next; next < end; ++it, ++next) {
+            std::invoke(fn, *it);
+          }
+          stats.visited += end - start;
+          return next >= size;
+        }
+    };
+  }  // namespace detail
+
+  /**
+   * @class versioned
+   * @brief A container paired with a structural counter that every mutable access bumps,
+   * so that chunked scans detect any change made between two chunks.
+   * @tparam C The wrapped container.
+   *
+   * The container is reachable as `const C&` through `get()`, and as `C&` only through
+   * `modify()`, which bumps the counter: no insertion or erasure can bypass it. A scan
+   * still hands its callback mutable elements.
+   *
+   * @code
+   * rmutex<versioned<std::vector<job>>> queue;
+   * queue.lock()->modify().push_back(next_job);
+   * @endcode
+   */
+  template <typename C>
+  class versioned {
+      C           _container;
+      std::size_t _version = 0;
+
+      template <typename>
+      friend struct detail::chunk_cursor;
+
+    public:
+      versioned() = default;
+
+      explicit versioned(C container): _container(std::move(container)) { }
+
+      /// @brief Read-only access; does not count as a change.
+      const C& get() const noexcept { return _container; }
+
+      /// @brief Mutable access; counts as a structural change, whatever the caller does with it.
+      C& modify() noexcept {
+        ++_version;
+        return _container;
+      }
+
+      /// @brief The number of `modify()` calls so far.
+      std::size_t structural_version() const noexcept { return _version; }
+  };
+
+  namespace detail {
+    // The cursor of the wrapped container, checked against the real modification counter.
+    template <typename C>
+    struct chunk_cursor<versioned<C>> : chunk_cursor<C> {
+        static std::size_t version_of(const versioned<C>& v) noexcept { return v.structural_version(); }
+
+        void restart(const versioned<C>& v) { chunk_cursor<C>::restart(v._container); }
+
+        void rebase(const versioned<C>& v) { chunk_cursor<C>::rebase(v._container); }
+
+        template <typename Fn>
+        bool step(versioned<C>& v, std::size_t chunk_size, Fn& fn, chunked_stats& stats) {
+          return chunk_cursor<C>::step(v._container, chunk_size, fn, stats);
+        }
+    };
+  }  // namespace detail
+
+  /**
+   * @class chunked_scan
+   * @brief A resumable scan over the container inside an rmutex, one locked chunk at a time.
+   * @tparam T The container type protected by the rmutex.
+   * @tparam Mutex The lock backend of the rmutex.
+   *
+   * Every `next_chunk()` locks the rmutex, checks the structural version recorded by the
+   * previous chunk, applies the `chunk_policy` if it changed, visits about `chunk_size`
+   * elements (unordered containers finish the current bucket) and unlocks.
+   *
+   * @code
+   * chunked_scan scan(sessions, 256);
+   * while (scan.next_chunk([](auto& entry) { expire(entry); })) {
+   *   // The lock is released here; writers can get in.
+   * }
+   * @endcode
+   */
+  template <typename T, typename Mutex = std::mutex>
+  class chunked_scan {
+      rmutex<T, Mutex>&        _mutex;
+      std::size_t              _chunk_size;
+      chunk_policy             _policy;
+      detail::chunk_cursor<T>  _cursor;
+      chunked_stats            _stats;
+      bool                     _done = false;
+
+    public:
+      chunked_scan(rmutex<T, Mutex>& mutex, std::size_t chunk_size, chunk_policy policy = chunk_policy::restart):
+          _mutex(mutex), _chunk_size(chunk_size ? chunk_size : 1), _policy(policy) { }
+
+      /**
+       * @brief Visits the next chunk under the lock.
+       * @param fn Called with a reference to every element of the chunk.
+       * @return True while elements remain, false once the scan has completed.
+       */
+      template <typename Fn>
+      bool next_chunk(Fn&& fn) {
+        if (_done) {
+          return false;
+        }
+        rmutex_ref<T, Mutex> data = _mutex.lock();
+        T&                   container = *data;
+        if (_stats.chunks++ != 0 && _cursor.version != _cursor.version_of(container)) {
+          ++_stats.structural_changes;
+          if (_policy == chunk_policy::restart) {
+            _cursor.restart(container);
+          } else {
+            _cursor.rebase(container);
+          }
+        }
+        _cursor.version = _cursor.version_of(container);
+        _done           = _cursor.step(container, _chunk_size, fn, _stats);
+        return !_done;
+      }
+
+      /// @brief Whether every chunk has been visited.
+      bool done() const noexcept { return _done; }
+
+      const chunked_stats& stats() const noexcept { return _stats; }
+  };
+
+  /**
+   * @brief Calls `fn` on every element of the container inside `mutex`, releasing the lock
+   * (and yielding to waiting threads) after every chunk of about `chunk_size` elements.
+   * @param policy What to do if the container changed structurally between chunks.
+   * @return The counters of the scan.
+   */
+  template <typename T, typename Mutex, typename Fn>
+  chunked_stats for_each_chunked(rmutex<T, Mutex>& mutex, std::size_t chunk_size, Fn&& fn, chunk_policy policy = chunk_policy::restart) {
+    chunked_scan<T, Mutex> scan(mutex, chunk_size, policy);
+    while (scan.next_chunk(fn)) {
+      std::this_thread::yield();
+    }
+    return scan.stats();
+  }
+}  // namespace rmutexpp
+#endif  // _CHUNKED_ITERATION_HEADER_
@@ -0,0 +1,287 @@
+/**
+ * @file deferred_destruction.hpp
+ * @brief Defines the machinery behind `rmutex_ref::defer_after_unlock()` and
+ * `rmutex_ref::retire()` (and their rmutex_guard counterparts): objects removed from a
+ * protected value under the lock are destroyed only after the lock is released.
+ *
+ * Doomed objects are moved into a small per-thread buffer of inline slots, tagged with
+ * the rmutex they were removed from. When the ref or guard releases that lock it
+ * destroys its own entries on the spot, or hands them to a `background_reclaimer`
+ * thread. The buffer lives in thread-local storage rather than in the ref, so refs
+ * keep their size and a release without deferred objects pays one thread-local load.
+ *
+ * Objects that are too large for a slot, or that cannot be moved without throwing, and
+ * objects deferred once the slots are full, are boxed on the heap instead. Retired
+ * objects are always boxed, at `retire()` time: the box is what the reclaimer queues,
+ * so releasing the lock, which must not throw, never allocates.
+ *
+ * Entries belong to the thread that deferred them. A ref or guard with pending entries
+ * should be released on that thread: released on another one, it flushes that thread's
+ * buffer instead, and its entries wait for the next release of the same rmutex on the
+ * deferring thread. Whatever is still pending when a thread exits is destroyed then,
+ * on the exiting thread, retired objects included.
+ */
+#ifndef _DEFERRED_DESTRUCTION_HEADER_
+#define _DEFERRED_DESTRUCTION_HEADER_
+
+#include <condition_variable>  // For std::condition_variable
+#include <cstddef>             // For std::size_t
+#include <mutex>               // For std::mutex, std::lock_guard, std::unique_lock
+#include <new>                 // For placement new
+#include <thread>              // For std::thread
+#include <type_traits>         // For std::is_nothrow_move_constructible_v
+#include <utility>             // For std::move, std::exchange
+
+namespace rmutexpp {
+  class background_reclaimer;
+
+  namespace detail {
+    // A heap-allocated doomed object; also the node type of the overflow list.
+    struct deferred_object {
+        virtual ~deferred_object() = default;
+
+        deferred_object*      next   = nullptr;
+        const void*           owner  = nullptr;
+        background_reclaimer* target = nullptr;
+    };
+
+    template <typename T>
+    struct deferred_box final : deferred_object {
+        T value;
+
+        explicit deferred_box(T&& doomed): value(std::move(doomed)) { }
+    };
+
+    struct deferred_ops {
+        void (*destroy)(void* storage) noexcept;
+        void (*relocate)(void* to, void* from) noexcept;
+    };
+
+    template <typename T>
+    inline constexpr deferred_ops deferred_ops_for {
+      [](void* storage) noexcept { static_cast<T*>(storage)->~T(); },
+      [](void* to, void* from) noexcept {
+        ::new (to) T(std::move(*static_cast<T*>(from)));
+        static_cast<T*>(from)->~T();
+      },
+    };
+
+    inline constexpr std::size_t deferred_slot_size  = 64;
+    inline constexpr std::size_t deferred_slot_align = 16;
+    inline constexpr std::size_t deferred_slot_count = 8;
+
+    // Only holds objects destroyed by the releasing thread itself; retired ones are boxed.
+    struct deferred_slot {
+        alignas(deferred_slot_align) unsigned char storage[deferred_slot_size];
+        const deferred_ops* ops;
+        const void*         owner;
+    };
+
+    // Trivially constructible, so accessing it never goes through a thread-local initialization guard.
+    struct deferred_queue {
+        std::size_t      pending;  ///< Entries in `slots` plus entries in `overflow`.
+        std::size_t      used;
+        deferred_slot    slots[deferred_slot_count];
+        deferred_object* overflow;
+    };
+
+    inline thread_local deferred_queue tls_deferred_queue {};
+
+    template <typename T>
+    inline constexpr bool fits_deferred_slot =
+        sizeof(T) <= deferred_slot_size && alignof(T) <= deferred_slot_align && std::is_nothrow_move_constructible_v<T>;
+
+    /// @brief Whether the calling thread has deferred objects waiting for an unlock.
+    inline bool deferred_pending() noexcept { return tls_deferred_queue.pending != 0; }
+
+    /**
+     * @brief Whether the calling thread still holds `lock` after releasing one level of it.
+     *
+     * Only a recursive backend re-entered by an outer ref or guard can answer yes: the
+     * entries deferred under the inner one then wait for the outermost release.
+     */
+    template <typename Lockable>
+    bool still_held_by_caller(const Lockable& lock) noexcept {
+      if constexpr (requires { lock.held_by_caller(); }) {
+        return lock.held_by_caller();
+      } else {
+        return false;
+      }
+    }
+
+    // Destroys every entry of the exiting thread; defined after background_reclaimer.
+    struct deferred_exit_flush {
+        ~deferred_exit_flush();
+    };
+
+    // A separate object, so that only deferring threads register a thread-exit destructor.
+    inline void register_deferred_exit_flush() noexcept {
+      thread_local deferred_exit_flush registration;
+      (void) registration;
+    }
+
+    template <typename T>
+    void defer_destruction(const void* owner, background_reclaimer* target, T&& doomed) {
+      register_deferred_exit_flush();
+      deferred_queue& queue = tls_deferred_queue;
+      if constexpr (fits_deferred_slot<T>) {
+        if (!target && queue.used < deferred_slot_count) {
+          deferred_slot& slot = queue.slots[queue.used++];
+          ::new (static_cast<void*>(slot.storage)) T(std::move(doomed));
+          slot.ops   = &deferred_ops_for<T>;
+          slot.owner = owner;
+          ++queue.pending;
+          return;
+        }
+      }
+      deferred_object* boxed = new deferred_box<T>(std::move(doomed));
+      boxed->owner           = owner;
+      boxed->target          = target;
+      boxed->next            = std::exchange(queue.overflow, boxed);
+      ++queue.pending;
+    }
+
+    // Destroys (or hands off) every entry deferred under `owner`; defined after background_reclaimer.
+    inline void flush_deferred(const void* owner) noexcept;
+
+    // Destroys (or hands off) an object deferred while no lock is held: there is no unlock to wait for.
+    template <typename T>
+    void destroy_undeferred(background_reclaimer* target, T&& doomed);
+  }  // namespace detail
+
+  /**
+   * @class background_reclaimer
+   * @brief A thread that destroys objects retired with `rmutex_ref::retire()`.
+   *
+   * Useful when even destroying a doomed object after unlocking is too slow for the
+   * releasing thread (large trees, many allocations). Retired objects are boxed when
+   * they are retired and linked into the queue after the lock is released, which does
+   * not allocate; the reclaimer destroys them in batches.
+   * Destroying the reclaimer destroys whatever is still queued and joins the thread.
+   */
+  class background_reclaimer {
+      std::mutex               _queue_mutex;
+      std::condition_variable  _queued;
+      detail::deferred_object* _queue    = nullptr;  ///< Linked through `deferred_object::next`.
+      bool                     _stopping = false;
+      std::thread              _worker;
+
+      void run() {
+        while (true) {
+          detail::deferred_object* batch;
+          {
+            std::unique_lock<std::mutex> lock(_queue_mutex);
+            _queued.wait(lock, [&] { return _stopping || _queue; });
+            if (!_queue) {
+              return;
+            }
+            batch = std::exchange(_queue, nullptr);
+          }
+          while (batch) {
+            delete std::exchange(batch, batch->next);
+          }
+        }
+      }
+
+    public:
+      background_reclaimer(): _worker([this] { run(); }) { }
+
+      background_reclaimer(const background_reclaimer&)            = delete;
+      background_reclaimer& operator=(const background_reclaimer&) = delete;
+
+      ~background_reclaimer() {
+        {
+          std::lock_guard<std::mutex> lock(_queue_mutex);
+          _stopping = true;
+        }
+        _queued.notify_one();
+        _worker.join();
+      }
+
+      /// @brief Queues a boxed object for destruction on the reclaimer thread; links it, never allocates.
+      void push(detail::deferred_object* doomed) noexcept {
+        {
+          std::lock_guard<std::mutex> lock(_queue_mutex);
+          doomed->next = std::exchange(_queue, doomed);
+        }
+        _queued.notify_one();
+      }
+  };
+
+  namespace detail {
+    inline void flush_deferred(const void* owner) noexcept {
+      deferred_queue& queue = tls_deferred_queue;
+      // Detach this owner's entries first: their destructors may lock other rmutexes and defer again.
+      deferred_slot mine[deferred_slot_count];
+      std::size_t   taken = 0;
+      std::size_t   kept  = 0;
+      for (std::size_t i = 0; i < queue.used; ++i) {
+        deferred_slot& slot = queue.slots[i];
+        deferred_slot& to   = slot.owner == owner ? mine[taken++] : queue.slots[kept++];
+        if (&to != &slot) {
+          slot.ops->relocate(to.storage, slot.storage);
+          to.ops   = slot.ops;
+          to.owner = slot.owner;
+        }
+      }
+      queue.used = kept;
+      deferred_object*  boxed = nullptr;
+      deferred_object** link  = &queue.overflow;
+      std::size_t       boxes = 0;
+      while (*link) {
+        if ((*link)->owner == owner) {
+          deferred_object* found = *link;
+          *link                  = found->next;
+          found->next            = std::exchange(boxed, found);
+          ++boxes;
+        } else {
+          link = &(*link)->next;
+        }
+      }
+      queue.pending -= taken + boxes;
+
+      for (std::size_t i = 0; i < taken; ++i) {
+        mine[i].ops->destroy(mine[i].storage);
+      }
+      while (boxed) {
+        deferred_object* doomed = std::exchange(boxed, boxed->next);
+        if (doomed->target) {
+          doomed->target->push(doomed);
+        } else {
+          delete doomed;
+        }
+      }
+    }
+
+    template <typename T>
+    void destroy_undeferred(background_reclaimer* target, T&& doomed) {
+      if (target) {
+        target->push(new deferred_box<T>(std::move(doomed)));
+      } else {
+        T dropped(std::move(doomed));
+      }
+    }
+
+    inline deferred_exit_flush::~deferred_exit_flush() {
+      deferred_queue& queue = tls_deferred_queue;
+      // Destructors may defer again, and the reclaimers these entries named may already be gone.
+      while (queue.pending != 0) {
+        deferred_slot mine[deferred_slot_count];
+        std::size_t   taken = std::exchange(queue.used, 0);
+        for (std::size_t i = 0; i < taken; ++i) {
+          queue.slots[i].ops->relocate(mine[i].storage, queue.slots[i].storage);
+          mine[i].ops = queue.slots[i].ops;
+        }
+        deferred_object* boxed = std::exchange(queue.overflow, nullptr);
+        queue.pending          = 0;
+        for (std::size_t i = 0; i < taken; ++i) {
+          mine[i].ops->destroy(mine[i].storage);
+        }
+        while (boxed) {
+          delete std::exchange(boxed, boxed->next);
+        }
+      }
+    }
+  }  // namespace detail
+}  // namespace rmutexpp
+#endif  // _DEFERRED_DESTRUCTION_HEADER_
@@ -0,0 +1,153 @@
+/**
+ * @file epoch_reclamation.hpp
+ * @brief Defines the process-wide epoch-based reclamation domain used by lock-free lists
+ * whose nodes may still be read after they are unlinked (`range_rmutex`).
+ *
+ * A thread that traverses shared nodes first announces the global epoch in its own
+ * cache-line-sized slot, and clears the slot when it is done. Unlinked nodes are retired
+ * into bags owned by the retiring thread's slot, tagged with the epoch of their
+ * retirement. The global epoch only moves on once every thread inside a traversal has
+ * announced the current one, so a bag becomes safe to reclaim two epochs after its tag:
+ * every traversal that could have seen its nodes has finished by then.
+ *
+ * Entering and leaving a traversal only write the thread's own slot, and retiring only
+ * touches bags of that slot: threads working on unrelated data share no written cache
+ * line. Every `epoch_advance_interval` retirements, the retiring thread scans the slots
+ * and tries to advance the epoch. A slot is released when its thread exits; the bags it
+ * still holds are inherited by the next thread that claims it.
+ */
+#ifndef _EPOCH_RECLAMATION_HEADER_
+#define _EPOCH_RECLAMATION_HEADER_
+
+#include <atomic>   // For std::atomic
+#include <cstdint>  // For std::uint64_t
+#include <utility>  // For std::exchange
+
+namespace rmutexpp {
+  namespace detail {
+    /// @brief The header of a node that can be retired: an intrusive link and the function reclaiming it.
+    struct epoch_retired {
+        epoch_retired* retired_next = nullptr;
+        void (*reclaim)(epoch_retired*) noexcept = nullptr;
+    };
+
+    inline constexpr std::uint64_t epoch_idle             = ~std::uint64_t { 0 };
+    inline constexpr unsigned      epoch_bag_count        = 3;
+    inline constexpr unsigned      epoch_advance_interval = 64;
+
+    /// @brief A thread's announcement and its retired nodes. Only `announced` and `claimed` are shared.
+    struct alignas(64) epoch_slot {
+        std::atomic<std::uint64_t> announced { epoch_idle };
+        std::atomic<bool>          claimed { true };
+        epoch_slot*                next = nullptr;  ///< Registry link, immutable once published.
+
+        epoch_retired* bags[epoch_bag_count]       = { };
+        std::uint64_t  bag_epochs[epoch_bag_count] = { };
+        unsigned       since_advance               = 0;
+    };
+
+    struct alignas(64) epoch_domain_state {
+        std::atomic<std::uint64_t> epoch { 0 };
+        std::atomic<epoch_slot*>   slots { nullptr };  ///< Slots are never freed, only reused.
+    };
+
+    inline epoch_domain_state epoch_domain;
+
+    inline void reclaim_chain(epoch_retired* chain) noexcept {
+      while (chain) {
+        epoch_retired* retired = std::exchange(chain, chain->retired_next);
+        retired->reclaim(retired);
+      }
+    }
+
+    inline epoch_slot* claim_epoch_slot() {
+      for (epoch_slot* slot = epoch_domain.slots.load(std::memory_order_acquire); slot; slot = slot->next) {
+        bool unclaimed = false;
+        if (!slot->claimed.load(std::memory_order_relaxed) &&
+            slot->claimed.compare_exchange_strong(unclaimed, true, std::memory_order_acquire, std::memory_order_relaxed)) {
+          return slot;
+        }
+      }
+      epoch_slot* slot = new epoch_slot;
+      epoch_slot* head = epoch_domain.slots.load(std::memory_order_relaxed);
+      do {
+        slot->next = head;
+      } while (!epoch_domain.slots.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+      return slot;
+    }
+
+    struct epoch_participant {
+        epoch_slot* slot = claim_epoch_slot();
+
+        ~epoch_participant() { slot->claimed.store(false, std::memory_order_release); }
+    };
+
+    inline epoch_slot& this_thread_epoch_slot() {
+      thread_local epoch_participant participant;
+      return *participant.slot;
+    }
+
+    /// @brief Advances the global epoch if every thread inside a traversal has announced the current one.
+    inline void try_advance_epoch() noexcept {
+      std::uint64_t epoch = epoch_domain.epoch.load(std::memory_order_seq_cst);
+      for (epoch_slot* slot = epoch_domain.slots.load(std::memory_order_acquire); slot; slot = slot->next) {
+        std::uint64_t announced = slot->announced.load(std::memory_order_seq_cst);
+        if (announced != epoch_idle && announced != epoch) {
+          return;
+        }
+      }
+      epoch_domain.epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+    }
+
+    /**
+     * @class epoch_guard
+     * @brief Marks the calling thread as traversing shared nodes for its lifetime.
+     *
+     * Nodes read through the guard stay allocated until it is destroyed, even when
+     * other threads retire them meanwhile. Guards do not nest.
+     */
+    class epoch_guard {
+        epoch_slot& _slot;
+
+      public:
+        epoch_guard(): _slot(this_thread_epoch_slot()) {
+          // A read-modify-write rather than a store and a fence: the announcement is ordered
+          // before every read of the traversal, which is all that reclamation relies on.
+          _slot.announced.exchange(epoch_domain.epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        }
+
+        epoch_guard(const epoch_guard&)            = delete;
+        epoch_guard& operator=(const epoch_guard&) = delete;
+
+        ~epoch_guard() { _slot.announced.store(epoch_idle, std::memory_order_release); }
+
+        /**
+         * @brief Hands an unlinked node over for reclamation once no traversal can reach it.
+         * @pre No new traversal can reach `retired`.
+         */
+        void retire(epoch_retired* retired) noexcept {
+          std::uint64_t epoch = epoch_domain.epoch.load(std::memory_order_seq_cst);
+          unsigned      bag   = static_cast<unsigned>(epoch % epoch_bag_count);
+          if (_slot.bag_epochs[bag] != epoch) {
+            // The bag holds nodes from at least three epochs ago.
+            reclaim_chain(std::exchange(_slot.bags[bag], nullptr));
+            _slot.bag_epochs[bag] = epoch;
+          }
+          retired->retired_next = _slot.bags[bag];
+          _slot.bags[bag]       = retired;
+          if (++_slot.since_advance < epoch_advance_interval) {
+            return;
+          }
+          _slot.since_advance = 0;
+          try_advance_epoch();
+          epoch = epoch_domain.epoch.load(std::memory_order_seq_cst);
+          for (unsigned other = 0; other < epoch_bag_count; ++other) {
+            if (_slot.bags[other] && _slot.bag_epochs[other] + 2 <= epoch) {
+              reclaim_chain(std::exchange(_slot.bags[other], nullptr));
+            }
+          }
+        }
+    };
+  }  // namespace detail
+}  // namespace rmutexpp
+#endif  // _EPOCH_RECLAMATION_HEADER_
@@ -0,0 +1,273 @@
+/**
+ * @file growth.hpp
+ * @brief Defines lock_for_growth and growth_traits, a protocol that allocates the new
+ * storage of a growing container *before* taking the lock of its rmutex.
+ *
+ * A `push_back` that reallocates a large `std::vector`, or an insert that rehashes a
+ * large `std::unordered_map`, allocates and migrates the whole container while every
+ * other thread waits for the lock. `lock_for_growth(mutex, extra)` instead:
+ *
+ * 1. locks briefly to check whether `extra` more elements would grow the container and,
+ *    if so, how much storage the grown container needs;
+ * 2. allocates that storage with the lock released;
+ * 3. locks again and, unless the container no longer needs to grow, moves the elements
+ *    into the new storage and swaps it in, retrying from step 2 if the container
+ *    outgrew the new storage in between;
+ * 4. returns the locked reference. The old storage is destroyed only after that
+ *    reference releases the lock (see `defer_after_unlock()`).
+ *
+ * `std::deque` never relocates its elements when it grows: each new block is a small
+ * fixed-size allocation. Its growth never needs staging, so `lock_for_growth` on a
+ * deque simply locks. The library's own containers do not grow under an rmutex either
+ * (`range_rmutex` is fixed-size and `olc_btree` allocates one node at a time outside
+ * any structure-wide lock). Other containers opt in by specializing `growth_traits`.
+ *
+ * Migrating must not lose elements if it throws halfway. A vector stages only when its
+ * elements can be moved without throwing, or else copied (the original is left intact
+ * if a copy throws); an unordered container stages only when its hash function and key
+ * equality cannot throw, since `merge()` calls them. Other containers lock and grow in
+ * place, under the lock.
+ */
+#ifndef _GROWTH_HEADER_
+#define _GROWTH_HEADER_
+
+#include <cstddef>        // For std::size_t
+#include <deque>          // For std::deque
+#include <functional>     // For std::equal_to
+#include <iterator>       // For std::make_move_iterator
+#include <optional>       // For std::optional
+#include <type_traits>    // For std::is_nothrow_move_constructible_v, std::is_copy_constructible_v, std::is_nothrow_invocable_v
+#include <unordered_map>  // For std::unordered_map, std::unordered_multimap
+#include <unordered_set>  // For std::unordered_set, std::unordered_multiset
+#include <utility>        // For std::move, std::declval
+#include <vector>         // For std::vector
+
+#include "rmutex.hpp"  // For rmutex, rmutex_ref
+
+namespace rmutexpp {
+
+  /**
+   * @struct growth_traits
+   * @brief Customization point describing how a container grows into storage allocated outside the lock.
+   * @tparam C The container type.
+   *
+   * A specialization provides:
+   * - `storage_type`: an object owning allocated storage, usually an empty `C`;
+   * - `std::optional<std::size_t> growth_target(const C&, std::size_t extra)`: the size to allocate for,
+   *   or `std::nullopt` if `extra` more elements fit without growing (called under the lock);
+   * - `storage_type make_storage(const C&)`: an empty storage sharing the container's allocator and
+   *   function objects, without allocating (called under the lock);
+   * - `void allocate(storage_type&, std::size_t target)`: allocates (called without the lock);
+   * - `bool fits(const storage_type&, const C&, std::size_t extra)`: whether the storage can take the
+   *   container plus `extra` elements (called under the lock);
+   * - `void migrate(C&, storage_type&)`: moves the elements into the storage and swaps it in; the old
+   *   storage is left in the `storage_type` (called under the lock);
+   * - `void grow_in_place(C&, std::size_t target)`: the fallback used when staging keeps losing the race.
+   * - optionally, `static constexpr bool can_stage`: false when `migrate` could throw after moving some
+   *   elements out; `lock_for_growth` then only ever grows in place. Defaults to true.
+   *
+   * The primary template is left undefined: containers without a specialization cannot be used with
+   * `lock_for_growth`.
+   */
+  template <typename C>
+  struct growth_traits;
+
+  /**
+   * @concept growable
+   * @brief Satisfied by containers with a `growth_traits` specialization.
+   */
+  template <typename C>
+  concept growable = requires(C& c, const C& cc, typename growth_traits<C>::storage_type& storage, std::size_t n) {
+    { growth_traits<C>::growth_target(cc, n) } -> std::same_as<std::optional<std::size_t>>;
+    { growth_traits<C>::make_storage(cc) } -> std::same_as<typename growth_traits<C>::storage_type>;
+    growth_traits<C>::allocate(storage, n);
+    { growth_traits<C>::fits(storage, cc, n) } -> std::convertible_to<bool>;
+    growth_traits<C>::migrate(c, storage);
+    growth_traits<C>::grow_in_place(c, n);
+  };
+
+  namespace detail {
+    template <typename C>
+    inline constexpr bool can_stage_growth = [] {
+      if constexpr (requires { growth_traits<C>::can_stage; }) {
+        return growth_traits<C>::can_stage;
+      } else {
+        return true;
+      }
+    }();
+  }  // namespace detail
+
+  /**
+   * @brief `std::vector` grows geometrically into a buffer reserved outside the lock.
+   *
+   * Elements are moved into the new buffer if that cannot throw, copied otherwise; a type
+   * that can only be moved, with a throwing move, is grown in place instead.
+   */
+  template <typename T, typename Alloc>
+  struct growth_traits<std::vector<T, Alloc>> {
+      using container_type = std::vector<T, Alloc>;
+      using storage_type   = std::vector<T, Alloc>;
+
+      static constexpr bool can_stage = std::is_nothrow_move_constructible_v<T> || std::is_copy_constructible_v<T>;
+
+      static std::optional<std::size_t> growth_target(const container_type& c, std::size_t extra) noexcept {
+        if (c.capacity() - c.size() >= extra) {
+          return std::nullopt;
+        }
+        std::size_t doubled = 2 * c.capacity();
+        return doubled > c.size() + extra ? doubled : c.size() + extra;
+      }
+
+      static storage_type make_storage(const container_type& c) { return storage_type(c.get_allocator()); }
+
+      static void allocate(storage_type& storage, std::size_t target) { storage.reserve(target); }
+
+      static bool fits(const storage_type& storage, const container_type& c, std::size_t extra) noexcept {
+        return storage.capacity() >= c.size() + extra;
+      }
+
+      static void migrate(container_type& c, storage_type& storage) {
+        if constexpr (std::is_nothrow_move_constructible_v<T>) {
+          storage.insert(storage.end(), std::make_move_iterator(c.begin()), std::make_move_iterator(c.end()));
+        } else {
+          storage.insert(storage.end(), c.cbegin(), c.cend());  // Leaves `c` intact if a copy throws.
+        }
+        c.swap(storage);
+      }
+
+      static void grow_in_place(container_type& c, std::size_t target) { c.reserve(target); }
+  };
+
+  namespace detail {
+    // std::equal_to does not declare its call operator noexcept, but the comparison it makes may be.
+    template <typename Eq, typename K>
+    inline constexpr bool nothrow_key_eq = std::is_nothrow_invocable_v<const Eq&, const K&, const K&>;
+
+    template <typename K>
+    inline constexpr bool nothrow_key_eq<std::equal_to<K>, K> = noexcept(std::declval<const K&>() == std::declval<const K&>());
+
+    // Unordered containers: the bucket array is allocated outside the lock, and the nodes are spliced
+    // into it by merge() without being reallocated. A throwing hash or key equality would leave the
+    // nodes merged so far in the storage, so such containers grow in place instead.
+    template <typename C>
+    struct unordered_growth_traits {
+        using container_type = C;
+        using storage_type   = C;
+
+        static constexpr bool can_stage = std::is_nothrow_invocable_v<const typename C::hasher&, const typename C::key_type&> &&
+                                          nothrow_key_eq<typename C::key_equal, typename C::key_type>;
+
+        static std::optional<std::size_t> growth_target(const C& c, std::size_t extra) noexcept {
+          if (static_cast<float>(c.size() + extra) <= c.max_load_factor() * static_cast<float>(c.bucket_count())) {
+            return std::nullopt;
+          }
+          return c.size() + extra;
+        }
+
+        static storage_type make_storage(const C& c) {
+          storage_type storage(0, c.hash_function(), c.key_eq(), c.get_allocator());
+          storage.max_load_factor(c.max_load_factor());
+          return storage;
+        }
+
+        static void allocate(storage_type& storage, std::size_t target) { storage.reserve(target); }
+
+        static bool fits(const storage_type& storage, const C& c, std::size_t extra) noexcept {
+          return static_cast<float>(c.size() + extra) <= storage.max_load_factor() * static_cast<float>(storage.bucket_count());
+        }
+
+        static void migrate(C& c, storage_type& storage) {
+          storage.merge(c);
+          c.swap(storage);
+        }
+
+        static void grow_in_place(C& c, std::size_t target) { c.reserve(target); }
+    };
+  }  // namespace detail
+
+  template <typename K, typename V, typename Hash, typename Eq, typename Alloc>
+  struct growth_traits<std::unordered_map<K, V, Hash, Eq, Alloc>>
+      : detail::unordered_growth_traits<std::unordered_map<K, V, Hash, Eq, Alloc>> { };
+
+  template <typename K, typename V, typename Hash, typename Eq, typename Alloc>
+  struct growth_traits<std::unordered_multimap<K, V, Hash, Eq, Alloc>>
+      : detail::unordered_growth_traits<std::unordered_multimap<K, V, Hash, Eq, Alloc>> { };
+
+  template <typename K, typename Hash, typename Eq, typename Alloc>
+  struct growth_traits<std::unordered_set<K, Hash, Eq, Alloc>> : detail::unordered_growth_traits<std::unordered_set<K, Hash, Eq, Alloc>> { };
+
+  template <typename K, typename Hash, typename Eq, typename Alloc>
+  struct growth_traits<std::unordered_multiset<K, Hash, Eq, Alloc>>
+      : detail::unordered_growth_traits<std::unordered_multiset<K, Hash, Eq, Alloc>> { };
+
+  /// @brief `std::deque` never relocates its elements, so it never needs staging.
+  template <typename T, typename Alloc>
+  struct growth_traits<std::deque<T, Alloc>> {
+      using container_type = std::deque<T, Alloc>;
+      struct storage_type { };
+
+      static std::optional<std::size_t> growth_target(const container_type&, std::size_t) noexcept { return std::nullopt; }
+
+      static storage_type make_storage(const container_type&) noexcept { return { }; }
+
+      static void allocate(storage_type&, std::size_t) noexcept { }
+
+      static bool fits(const storage_type&, const container_type&, std::size_t) noexcept { return true; }
+
+      static void migrate(container_type&, storage_type&) noexcept { }
+
+      static void grow_in_place(container_type&, std::size_t) noexcept { }
+  };
+
+  /// @brief Staging attempts made by `lock_for_growth` before it grows the container under the lock.
+  inline constexpr int growth_staging_attempts = 3;
+
+  /**
+   * @brief Locks `mutex` with room for `extra` more elements, allocating any new storage
+   * while the lock is released.
+   * @param mutex The rmutex holding the container.
+   * @param extra The number of elements about to be added.
+   * @return The locked reference. Adding up to `extra` elements through it does not
+   * reallocate (for unordered containers: does not rehash).
+   *
+   * @code
+   * auto log = lock_for_growth(entries, batch.size());
+   * log->insert(log->end(), batch.begin(), batch.end()); // No reallocation in here.
+   * @endcode
+   */
+  template <growable T, typename Mutex>
+  [[nodiscard]] rmutex_ref<T, Mutex> lock_for_growth(rmutex<T, Mutex>& mutex, std::size_t extra) {
+    using traits = growth_traits<T>;
+    std::optional<rmutex_ref<T, Mutex>> data;
+    data.emplace(mutex);
+    if constexpr (detail::can_stage_growth<T>) {
+      for (int attempt = 0; attempt < growth_staging_attempts; ++attempt) {
+        std::optional<std::size_t> target = traits::growth_target(**data, extra);
+        if (!target) {
+          return std::move(*data);
+        }
+        typename traits::storage_type storage = traits::make_storage(**data);
+        data.reset();
+        traits::allocate(storage, *target);
+        data.emplace(mutex);
+        if (!traits::growth_target(**data, extra)) {
+          // Another thread grew (or emptied) the container in the meantime: it has room already.
+          data->defer_after_unlock(std::move(storage));
+          return std::move(*data);
+        }
+        if (traits::fits(storage, **data, extra)) {
+          traits::migrate(**data, storage);
+          data->defer_after_unlock(std::move(storage));
+          return std::move(*data);
+        }
+        // The container grew past the staged storage in the meantime: stage again, bigger.
+        data->defer_after_unlock(std::move(storage));
+      }
+    }
+    if (std::optional<std::size_t> target = traits::growth_target(**data, extra)) {
+      traits::grow_in_place(**data, *target);
+    }
+    return std::move(*data);
+  }
+}  // namespace rmutexpp
+#endif  // _GROWTH_HEADER_
@@ -0,0 +1,421 @@
+/**
+ * @file hierarchical_rmutex.hpp
+ * @brief Defines hierarchical_rmutex, an rmutex arranged in a tree (tenant, table, row, ...)
+ * that supports database-style multi-granularity locking, and the RAII types that hold
+ * those locks: hierarchical_ref for one node and hierarchical_guard for several.
+ *
+ * Every node can be locked in one of five modes (Gray et al., "Granularity of Locks in
+ * a Shared Data Base", 1975):
+ *
+ * | mode | meaning                                             | access to the node |
+ * |------|-----------------------------------------------------|--------------------|
+ * | IS   | intends to read some descendants                    | none               |
+ * | IX   | intends to write some descendants                   | none               |
+ * | S    | reads the node and its whole subtree                | `const T&`         |
+ * | SIX  | reads the whole subtree, writes some descendants    | `const T&`         |
+ * | X    | writes the node and its whole subtree               | `T&`               |
+ *
+ * Locking a node first takes IS (for IS/S) or IX (for IX/SIX/X) on each of its
+ * ancestors, root first, so a row writer and a table scan conflict on the table while
+ * row writers in different tables never meet. Locks are always acquired in the same
+ * global order (by depth, then by address), which makes every guard deadlock-free.
+ */
+#ifndef _HIERARCHICAL_RMUTEX_HEADER_
+#define _HIERARCHICAL_RMUTEX_HEADER_
+
+#include <algorithm>    // For std::sort
+#include <atomic>       // For std::atomic
+#include <cstddef>      // For std::size_t
+#include <cstdint>      // For std::uint64_t
+#include <functional>   // For std::less
+#include <tuple>        // For std::tuple, std::apply
+#include <type_traits>  // For std::is_const
+#include <utility>      // For std::forward, std::exchange, std::pair
+#include <vector>       // For std::vector
+
+#include "parking_table.hpp"  // For detail::park, detail::unpark_all
+
+namespace rmutexpp {
+
+  /**
+   * @enum lock_mode
+   * @brief The five multi-granularity lock modes, from weakest to strongest.
+   */
+  enum class lock_mode : unsigned char {
+    intention_shared,            ///< IS
+    intention_exclusive,         ///< IX
+    shared,                      ///< S
+    shared_intention_exclusive,  ///< SIX
+    exclusive                    ///< X
+  };
+
+  /**
+   * @brief Whether a lock in mode `requested` can be granted while `held` is held by someone else.
+   */
+  constexpr bool lock_modes_compatible(lock_mode requested, lock_mode held) noexcept {
+    constexpr bool matrix[5][5] = {
+      //  IS     IX     S      SIX    X
+      { true, true, true, true, false },        // IS
+      { true, true, false, false, false },      // IX
+      { true, false, true, false, false },      // S
+      { true, false, false, false, false },     // SIX
+      { false, false, false, false, false },    // X
+    };
+    return matrix[static_cast<unsigned>(requested)][static_cast<unsigned>(held)];
+  }
+
+  /**
+   * @brief The weakest mode that covers both `a` and `b`, used when one guard needs a node twice.
+   */
+  constexpr lock_mode combine_lock_modes(lock_mode a, lock_mode b) noexcept {
+    if (a == b) {
+      return a;
+    }
+    if (a == lock_mode::exclusive || b == lock_mode::exclusive) {
+      return lock_mode::exclusive;
+    }
+    if (a == lock_mode::intention_shared) {
+      return b;
+    }
+    if (b == lock_mode::intention_shared) {
+      return a;
+    }
+    // Any two distinct modes among IX, S and SIX.
+    return lock_mode::shared_intention_exclusive;
+  }
+
+  /**
+   * @brief The mode taken on every ancestor of a node locked in mode `mode`.
+   */
+  constexpr lock_mode ancestor_lock_mode(lock_mode mode) noexcept {
+    return mode == lock_mode::intention_shared || mode == lock_mode::shared ? lock_mode::intention_shared : lock_mode::intention_exclusive;
+  }
+
+  /**
+   * @class hierarchical_lock
+   * @brief The lock state of one node of a hierarchy, independent of the data it protects.
+   *
+   * All grants live in one atomic word: a 20-bit count each for IS, IX and S, one bit each
+   * for SIX and X (neither is compatible with itself), and a bit recording that some
+   * request is waiting. A compatible request is granted with a single compare-and-swap,
+   * so row writers sharing IX on a table or a root never block each other. Only a
+   * request that conflicts with a granted mode sets the waiting bit and parks on the
+   * process-wide parking table; releases only wake the bucket when that bit is set.
+   * Waiters are not queued, so a steady stream of compatible requests can delay an
+   * incompatible one.
+   */
+  class hierarchical_lock {
+      static constexpr unsigned      count_bits  = 20;
+      static constexpr std::uint64_t count_mask  = (std::uint64_t { 1 } << count_bits) - 1;
+      static constexpr std::uint64_t waiting_bit = std::uint64_t { 1 } << (3 * count_bits + 2);
+
+      /// @brief The amount added to the state word by one grant of each mode.
+      static constexpr std::uint64_t grant_units[5] = {
+        std::uint64_t { 1 },                           // IS
+        std::uint64_t { 1 } << count_bits,             // IX
+        std::uint64_t { 1 } << (2 * count_bits),       // S
+        std::uint64_t { 1 } << (3 * count_bits),       // SIX
+        std::uint64_t { 1 } << (3 * count_bits + 1),   // X
+      };
+
+      static constexpr std::uint64_t field_mask(unsigned mode) noexcept {
+        return mode < 3 ? count_mask << (mode * count_bits) : grant_units[mode];
+      }
+
+      /// @brief The bits of the state word that must all be clear for `mode` to be granted.
+      static constexpr std::uint64_t conflicts(lock_mode mode) noexcept {
+        std::uint64_t mask = 0;
+        for (unsigned held = 0; held < 5; ++held) {
+          if (!lock_modes_compatible(mode, static_cast<lock_mode>(held))) {
+            mask |= field_mask(held);
+          }
+        }
+        return mask;
+      }
+
+      static bool grantable(std::uint64_t state, lock_mode mode) noexcept { return (state & conflicts(mode)) == 0; }
+
+      hierarchical_lock* _parent;
+      std::size_t        _depth;
+
+      std::atomic<std::uint64_t> _state { 0 };
+
+    protected:
+      explicit hierarchical_lock(hierarchical_lock* parent) noexcept: _parent(parent), _depth(parent ? parent->_depth + 1 : 0) { }
+
+    public:
+      hierarchical_lock(const hierarchical_lock&)            = delete;
+      hierarchical_lock& operator=(const hierarchical_lock&) = delete;
+
+      /// @brief The parent node, or `nullptr` for a root.
+      hierarchical_lock* parent() const noexcept { return _parent; }
+
+      /// @brief Number of ancestors (0 for a root).
+      std::size_t depth() const noexcept { return _depth; }
+
+      /**
+       * @brief Grants `mode` on this node alone, blocking until it is compatible with every granted mode.
+       * @pre Fewer than 2^20 grants of `mode` are held on this node.
+       */
+      void acquire(lock_mode mode) noexcept {
+        std::uint64_t unit  = grant_units[static_cast<unsigned>(mode)];
+        std::uint64_t state = _state.load(std::memory_order_relaxed);
+        while (true) {
+          if (grantable(state, mode)) {
+            if (_state.compare_exchange_weak(state, state + unit, std::memory_order_acquire, std::memory_order_relaxed)) {
+              return;
+            }
+            continue;
+          }
+          if (!(state & waiting_bit) &&
+              !_state.compare_exchange_weak(state, state | waiting_bit, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            continue;
+          }
+          detail::park(this, [&] {
+            std::uint64_t current = _state.load(std::memory_order_seq_cst);
+            return (current & waiting_bit) && !grantable(current, mode);
+          });
+          state = _state.load(std::memory_order_relaxed);
+        }
+      }
+
+      /// @brief Releases one grant of `mode` on this node, waking the waiters if there are any.
+      void release(lock_mode mode) noexcept {
+        if (_state.fetch_sub(grant_units[static_cast<unsigned>(mode)], std::memory_order_seq_cst) & waiting_bit) {
+          // Woken requests that still conflict set the bit again before parking.
+          _state.fetch_and(~waiting_bit, std::memory_order_seq_cst);
+          detail::unpark_all(this);
+        }
+      }
+
+      /// @brief Locks this node in `mode` and its ancestors in the matching intention mode, root first.
+      void acquire_path(lock_mode mode) noexcept {
+        if (_parent) {
+          _parent->acquire_path(ancestor_lock_mode(mode));
+        }
+        acquire(mode);
+      }
+
+      /// @brief Releases what `acquire_path(mode)` acquired, leaf first.
+      void release_path(lock_mode mode) noexcept {
+        release(mode);
+        if (_parent) {
+          _parent->release_path(ancestor_lock_mode(mode));
+        }
+      }
+  };
+
+  /**
+   * @struct child_of_t
+   * @brief Tag selecting the hierarchical_rmutex constructor that attaches the node to a parent.
+   */
+  struct child_of_t {
+      explicit child_of_t() = default;
+  };
+
+  inline constexpr child_of_t child_of {};
+
+  template <typename T, lock_mode Mode>
+  class hierarchical_ref;
+
+  template <typename... Ts>
+  class hierarchical_guard;
+
+  /**
+   * @class hierarchical_rmutex
+   * @brief One node of a lock hierarchy, protecting a value of type `T`.
+   * @tparam T The protected data type.
+   *
+   * Roots are constructed like an rmutex; children take `child_of` and their parent
+   * first. Nodes are neither copyable nor movable, since children point to their
+   * parent, and a parent must outlive its children.
+   *
+   * @code
+   * hierarchical_rmutex<tenant_info> tenant { "acme" };
+   * hierarchical_rmutex<table_info>  orders { child_of, tenant, "orders" };
+   * hierarchical_rmutex<order>       row    { child_of, orders, 42 };
+   *
+   * row.lock()->amount += 10;                         // IX tenant, IX orders, X row
+   * auto scan = orders.lock<lock_mode::shared>();     // IS tenant, S orders: waits for the row writer
+   * @endcode
+   */
+  template <typename T>
+  class hierarchical_rmutex : public hierarchical_lock {
+      static_assert(!std::is_const<T>::value, "hierarchical_rmutex cannot be instantiated with a const-qualified type.");
+
+      T _internal_data;  ///< The data protected by this node.
+
+      template <typename U, lock_mode Mode>
+      friend class hierarchical_ref;
+
+      template <typename... Ts>
+      friend class hierarchical_guard;
+
+    public:
+      /**
+       * @brief Constructs a root node, forwarding `args` to the constructor of `T`.
+       */
+      template <typename... Args>
+        requires(!std::is_same_v<std::remove_cvref_t<std::tuple_element_t<0, std::tuple<Args..., void>>>, child_of_t>)
+      explicit hierarchical_rmutex(Args&&... args): hierarchical_lock(nullptr), _internal_data(std::forward<Args>(args)...) { }
+
+      /**
+       * @brief Constructs a child of `parent`, forwarding `args` to the constructor of `T`.
+       */
+      template <typename... Args>
+      hierarchical_rmutex(child_of_t, hierarchical_lock& parent, Args&&... args):
+          hierarchical_lock(&parent), _internal_data(std::forward<Args>(args)...) { }
+
+      /**
+       * @brief Locks this node in `Mode`, taking the intention locks on its ancestors first.
+       * @tparam Mode The requested mode, exclusive by default.
+       * @return A reference whose data access matches `Mode` (none for IS/IX, `const T&` for S/SIX, `T&` for X).
+       */
+      template <lock_mode Mode = lock_mode::exclusive>
+      [[nodiscard]] hierarchical_ref<T, Mode> lock() {
+        return hierarchical_ref<T, Mode>(*this);
+      }
+
+      /// @brief Shorthand for `lock<lock_mode::shared>()`.
+      [[nodiscard]] hierarchical_ref<T, lock_mode::shared> lock_shared() { return lock<lock_mode::shared>(); }
+  };
+
+  /**
+   * @class hierarchical_ref
+   * @brief RAII holder of one node locked in `Mode` together with its ancestor intention locks.
+   * @tparam T The data type of the locked node.
+   * @tparam Mode The mode held on the node.
+   *
+   * Move-only, like rmutex_ref. Data accessors only exist for the modes that grant
+   * access to the node itself.
+   */
+  template <typename T, lock_mode Mode>
+  class hierarchical_ref {
+      hierarchical_rmutex<T>* _node;
+
+      explicit hierarchical_ref(hierarchical_rmutex<T>& node): _node(&node) { node.acquire_path(Mode); }
+
+      friend class hierarchical_rmutex<T>;
+
+      static constexpr bool readable = Mode == lock_mode::shared || Mode == lock_mode::shared_intention_exclusive;
+
+    public:
+      /// @brief Releases the node and then its ancestors.
+      ~hierarchical_ref() {
+        if (_node) {
+          std::exchange(_node, nullptr)->release_path(Mode);
+        }
+      }
+
+      hierarchical_ref(hierarchical_ref&& other) noexcept: _node(std::exchange(other._node, nullptr)) { }
+
+      hierarchical_ref& operator=(hierarchical_ref&& other) noexcept {
+        if (this != &other) {
+          if (_node) {
+            _node->release_path(Mode);
+          }
+          _node = std::exchange(other._node, nullptr);
+        }
+        return *this;
+      }
+
+      hierarchical_ref(const hierarchical_ref&)            = delete;
+      hierarchical_ref& operator=(const hierarchical_ref&) = delete;
+
+      /// @brief Mutable access, only under an exclusive lock.
+      T& operator*() const noexcept
+        requires(Mode == lock_mode::exclusive)
+      {
+        return _node->_internal_data;
+      }
+
+      T* operator->() const noexcept
+        requires(Mode == lock_mode::exclusive)
+      {
+        return &_node->_internal_data;
+      }
+
+      /// @brief Read-only access under S and SIX.
+      const T& operator*() const noexcept
+        requires readable
+      {
+        return _node->_internal_data;
+      }
+
+      const T* operator->() const noexcept
+        requires readable
+      {
+        return &_node->_internal_data;
+      }
+  };
+
+  /**
+   * @class hierarchical_guard
+   * @brief Locks several nodes of one hierarchy exclusively, without deadlock.
+   * @tparam Ts The data types of the guarded nodes.
+   *
+   * Gathers every node to lock (the targets in X, their ancestors in IX), merges
+   * duplicates with `combine_lock_modes`, and acquires them sorted by depth and then
+   * address. Since every guard and every hierarchical_ref follows that order, no cycle
+   * of waiters can form. Releases in the reverse order.
+   *
+   * @code
+   * hierarchical_guard transfer { row_a, row_b };
+   * auto [a, b] = transfer.get_data();
+   * @endcode
+   */
+  template <typename... Ts>
+  class hierarchical_guard {
+      std::tuple<hierarchical_rmutex<Ts>&...>            _nodes;
+      std::vector<std::pair<hierarchical_lock*, lock_mode>> _plan;
+
+      void add(hierarchical_lock& node, lock_mode mode) {
+        for (auto& [planned, planned_mode] : _plan) {
+          if (planned == &node) {
+            planned_mode = combine_lock_modes(planned_mode, mode);
+            return;
+          }
+        }
+        _plan.emplace_back(&node, mode);
+      }
+
+      void add_path(hierarchical_lock& node, lock_mode mode) {
+        add(node, mode);
+        for (hierarchical_lock* ancestor = node.parent(); ancestor; ancestor = ancestor->parent()) {
+          add(*ancestor, ancestor_lock_mode(mode));
+        }
+      }
+
+    public:
+      explicit hierarchical_guard(hierarchical_rmutex<Ts>&... nodes): _nodes(nodes...) {
+        (add_path(nodes, lock_mode::exclusive), ...);
+        std::sort(_plan.begin(), _plan.end(), [](const auto& a, const auto& b) {
+          return a.first->depth() != b.first->depth() ? a.first->depth() < b.first->depth()
+                                                      : std::less<hierarchical_lock*>()(a.first, b.first);
+        });
+        for (auto& [node, mode] : _plan) {
+          node->acquire(mode);
+        }
+      }
+
+      ~hierarchical_guard() {
+        for (auto step = _plan.rbegin(); step != _plan.rend(); ++step) {
+          step->first->release(step->second);
+        }
+      }
+
+      hierarchical_guard(const hierarchical_guard&)            = delete;
+      hierarchical_guard& operator=(const hierarchical_guard&) = delete;
+
+      /// @brief References to the data of every guarded node, in constructor order.
+      std::tuple<Ts&...> get_data() const& {
+        return std::apply([](auto&... nodes) { return std::tuple<Ts&...>(nodes._internal_data...); }, _nodes);
+      }
+
+      std::tuple<Ts&...> get_data() const&& = delete;
+  };
+
+  template <typename... Ts>
+  hierarchical_guard(hierarchical_rmutex<Ts>&...) -> hierarchical_guard<Ts...>;
+}  // namespace rmutexpp
+#endif  // _HIERARCHICAL_RMUTEX_HEADER_
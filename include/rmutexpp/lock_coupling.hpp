@@ -0,0 +1,165 @@
+/**
+ * @file lock_coupling.hpp
+ * @brief Defines coupled_iterator and lock_coupled, hand-over-hand ("lock coupling")
+ * traversal of linked structures whose nodes are individually wrapped in rmutex.
+ *
+ * A traversal holds the lock of the node it is on and acquires the next node's lock
+ * *before* releasing the one behind it, so no other thread can unlink or modify the
+ * node being stepped onto in between. Because each traversal only ever holds a
+ * window of two adjacent nodes, several traversals and updates can follow each other
+ * through a list or down a tree instead of serializing on one lock for the structure.
+ *
+ * @note All traversals of one structure must walk in the same direction (head to
+ * tail, root to leaves); that common order is what keeps lock coupling deadlock-free.
+ */
+#ifndef _LOCK_COUPLING_HEADER_
+#define _LOCK_COUPLING_HEADER_
+
+#include <concepts>    // For std::invocable
+#include <cstddef>     // For std::ptrdiff_t
+#include <functional>  // For std::invoke
+#include <iterator>    // For std::default_sentinel_t, std::input_iterator_tag
+#include <optional>    // For std::optional
+#include <utility>     // For std::forward, std::move
+
+#include "rmutex.hpp"  // For rmutex, rmutex_ref, RMUTEX_ASSERT
+
+namespace rmutexpp {
+
+  /**
+   * @class coupled_iterator
+   * @brief An input iterator that walks rmutex-protected nodes hand over hand.
+   * @tparam Node The node type stored in each `rmutex<Node, Mutex>`.
+   * @tparam Next A callable `rmutex<Node, Mutex>*(Node&)` returning the node to step onto,
+   * or `nullptr` at the end. It runs while the current node is locked.
+   * @tparam Mutex The lock backend of the nodes.
+   *
+   * The iterator keeps a window of at most two locks: the current node and the
+   * previous one. `operator++` first releases the previous node, then locks the next
+   * node while still holding the current one, and finally slides the window. Holding
+   * the predecessor is what lets `erase_current()` unlink the current node: no other
+   * traversal can reach it while its predecessor is locked. The iterator compares equal
+   * to `std::default_sentinel` once the walk has ended.
+   */
+  template <typename Node, typename Next, typename Mutex = std::mutex>
+  class coupled_iterator {
+      using node_ref = rmutex_ref<Node, Mutex>;
+
+      mutable std::optional<node_ref> _previous;
+      mutable std::optional<node_ref> _current;
+      Next                            _next;
+
+    public:
+      using value_type       = Node;
+      using reference        = Node&;
+      using difference_type  = std::ptrdiff_t;
+      using iterator_concept = std::input_iterator_tag;
+
+      /// @brief Locks `first` and positions the iterator on it; `nullptr` yields an ended iterator.
+      coupled_iterator(rmutex<Node, Mutex>* first, Next next): _next(std::move(next)) {
+        if (first) {
+          _current.emplace(*first);
+        }
+      }
+
+      coupled_iterator(coupled_iterator&&) = default;
+
+      coupled_iterator& operator=(coupled_iterator&&) = default;
+
+      /// @brief The current (locked) node.
+      Node& operator*() const { return **_current; }
+
+      Node* operator->() const { return &**this; }
+
+      /// @brief The previous node, still locked, or `nullptr` on the first node.
+      Node* previous() const { return _previous ? &**_previous : nullptr; }
+
+      /// @brief Steps onto the next node without ever leaving the current one unlocked in between.
+      coupled_iterator& operator++() {
+        _previous.reset();
+        rmutex<Node, Mutex>* next = std::invoke(_next, **_current);
+        if (next) {
+          _previous.emplace(std::move(*_current));
+          _current.reset();
+          _current.emplace(*next);
+        } else {
+          _current.reset();
+        }
+        return *this;
+      }
+
+      void operator++(int) { ++*this; }
+
+      /**
+       * @brief Unlinks and destroys the current node, then moves onto the node that follows `previous()`.
+       * @param unlink Called as `unlink(previous_node)` once the current node's lock is released;
+       * detaches the current node from `previous_node` and returns what owns it (such as its
+       * `std::unique_ptr`), which is destroyed right after.
+       * @pre `previous() != nullptr`: the first node has no locked predecessor to unlink it from.
+       *
+       * The current node is unlocked before `unlink` runs because its rmutex is usually
+       * destroyed with it, and a locked mutex must not be destroyed.
+       *
+       * @code
+       * it.erase_current([](list_node& previous) {
+       *   std::unique_ptr<rmutex<list_node>> erased = std::move(previous.next);
+       *   previous.next = std::move(erased->lock()->next);
+       *   return erased;
+       * });
+       * @endcode
+       */
+      template <typename Unlink>
+        requires std::invocable<Unlink, Node&>
+      void erase_current(Unlink&& unlink) {
+        RMUTEX_ASSERT(_previous.has_value(), "erase_current() on the first node");
+        _current.reset();
+        {
+          [[maybe_unused]] auto erased = std::invoke(std::forward<Unlink>(unlink), **_previous);
+        }
+        if (rmutex<Node, Mutex>* next = std::invoke(_next, **_previous)) {
+          _current.emplace(*next);
+        } else {
+          _previous.reset();
+        }
+      }
+
+      friend bool operator==(const coupled_iterator& it, std::default_sentinel_t) noexcept { return !it._current; }
+  };
+
+  /**
+   * @class coupled_range
+   * @brief The range returned by `lock_coupled`; `begin()` locks the first node.
+   */
+  template <typename Node, typename Next, typename Mutex = std::mutex>
+  class coupled_range {
+      rmutex<Node, Mutex>* _first;
+      Next                 _next;
+
+    public:
+      coupled_range(rmutex<Node, Mutex>* first, Next next): _first(first), _next(std::move(next)) { }
+
+      coupled_iterator<Node, Next, Mutex> begin() const { return coupled_iterator<Node, Next, Mutex>(_first, _next); }
+
+      std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+  };
+
+  /**
+   * @brief Walks a linked structure hand over hand, starting at `first`.
+   * @param first The first node to lock.
+   * @param next Returns the `rmutex` of the node after the given (locked) node, or `nullptr`.
+   *
+   * For a tree, `next` picks the child to descend into, so the range is a root-to-leaf path.
+   *
+   * @code
+   * struct list_node { int value; rmutex<list_node>* next = nullptr; };
+   * for (list_node& node : lock_coupled(head, [](list_node& n) { return n.next; })) {
+   *   ++node.value;  // Only this node and its predecessor are locked here.
+   * }
+   * @endcode
+   */
+  template <typename Node, typename Mutex, typename Next>
+  coupled_range<Node, Next, Mutex> lock_coupled(rmutex<Node, Mutex>& first, Next next) {
+    return coupled_range<Node, Next, Mutex>(&first, std::move(next));
+  }
+}  // namespace rmutexpp
+#endif  // _LOCK_COUPLING_HEADER_
@@ -0,0 +1,346 @@
+/**
+ * @file olc_btree.hpp
+ * @brief Defines olc_btree, a concurrent B+-tree synchronized with optimistic lock coupling.
+ *
+ * Every node embeds an `optimistic_lock`. Lookups descend from the root reading only
+ * versions: they validate a node after choosing the child and never write shared
+ * memory, so readers do not bounce cache lines between cores. Inserts descend the
+ * same way and upgrade to exclusive locks only on the nodes they modify (the leaf,
+ * plus the parent when a node splits). Any failed validation restarts the operation
+ * from the root. The design follows the B-tree of Leis et al., "The ART of Practical
+ * Synchronization" (DaMoN 2016).
+ *
+ * @note Optimistic readers may read keys and values while a writer modifies them;
+ * such reads are discarded by version validation. Keys, values and counts are therefore
+ * stored in `std::atomic`s and accessed with relaxed ordering, leaving all ordering to
+ * the version words; keys and values must be trivially copyable for that. Types that fit
+ * a lock-free atomic cost no more than plain loads and stores.
+ * Erasure is not supported, and nodes are only freed when the tree is destroyed.
+ */
+#ifndef _OLC_BTREE_HEADER_
+#define _OLC_BTREE_HEADER_
+
+#include <atomic>       // For std::atomic
+#include <concepts>     // For std::totally_ordered, std::default_initializable
+#include <cstddef>      // For std::size_t
+#include <cstdint>      // For std::uint64_t
+#include <optional>     // For std::optional
+#include <type_traits>  // For std::is_trivially_copyable_v
+
+#include "optimistic_lock.hpp"  // For optimistic_lock
+
+namespace rmutexpp {
+
+  /**
+   * @class olc_btree
+   * @brief An ordered map from `Key` to `Value` that scales with concurrent readers and writers.
+   * @tparam Key A trivially copyable, default-constructible, totally ordered key type.
+   * @tparam Value A trivially copyable, default-constructible value type.
+   * @tparam NodeCapacity The number of entries per node.
+   *
+   * @code
+   * olc_btree<std::uint64_t, std::uint64_t> index;
+   * index.insert_or_assign(42, 7);  // From any thread.
+   * if (auto value = index.find(42)) { use(*value); }
+   * @endcode
+   */
+  template <typename Key, typename Value, std::size_t NodeCapacity = 64>
+    requires std::totally_ordered<Key> && std::default_initializable<Key> && std::default_initializable<Value>
+  class olc_btree {
+      static_assert(std::is_trivially_copyable_v<Key>, "olc_btree keys are read optimistically and must be trivially copyable.");
+      static_assert(std::is_trivially_copyable_v<Value>, "olc_btree values are read optimistically and must be trivially copyable.");
+      static_assert(NodeCapacity >= 4, "olc_btree nodes need room for at least four entries.");
+
+      struct node {
+          optimistic_lock       lock;
+          std::atomic<unsigned> count { 0 };
+          const bool            is_leaf;
+
+          explicit node(bool leaf) noexcept: is_leaf(leaf) { }
+      };
+
+      // Inner nodes hold `count` separator keys and `count + 1` children; child i holds keys <= keys[i].
+      struct inner_node : node {
+          std::atomic<Key>   keys[NodeCapacity - 1];
+          std::atomic<node*> children[NodeCapacity];
+
+          inner_node() noexcept: node(false) { }
+
+          bool full() const noexcept { return this->count.load(std::memory_order_relaxed) == NodeCapacity - 1; }
+
+          // Splits off the upper half into a new node and returns it; `separator` receives the key moved up.
+          inner_node* split(Key& separator) {
+            unsigned    total = this->count.load(std::memory_order_relaxed);
+            inner_node* right = new inner_node();
+            unsigned    moved = total - total / 2;
+            unsigned    kept  = total - moved - 1;
+            separator         = keys[kept].load(std::memory_order_relaxed);
+            for (unsigned i = 0; i < moved; ++i) {
+              right->keys[i].store(keys[kept + 1 + i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            for (unsigned i = 0; i <= moved; ++i) {
+              right->children[i].store(children[kept + 1 + i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            right->count.store(moved, std::memory_order_relaxed);
+            this->count.store(kept, std::memory_order_relaxed);
+            return right;
+          }
+
+          // Inserts `separator` with `right` as the child just after it; the current child stays on the left.
+          void insert(const Key& separator, node* right) {
+            unsigned total = this->count.load(std::memory_order_relaxed);
+            unsigned pos   = lower_bound(keys, total, separator);
+            for (unsigned i = total; i > pos; --i) {
+              keys[i].store(keys[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+              children[i + 1].store(children[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            keys[pos].store(separator, std::memory_order_relaxed);
+            children[pos + 1].store(right, std::memory_order_relaxed);
+            this->count.store(total + 1, std::memory_order_relaxed);
+          }
+      };
+
+      struct leaf_node : node {
+          std::atomic<Key>   keys[NodeCapacity];
+          std::atomic<Value> values[NodeCapacity];
+
+          leaf_node() noexcept: node(true) { }
+
+          bool full() const noexcept { return this->count.load(std::memory_order_relaxed) == NodeCapacity; }
+
+          leaf_node* split(Key& separator) {
+            unsigned   total = this->count.load(std::memory_order_relaxed);
+            leaf_node* right = new leaf_node();
+            unsigned   moved = total - total / 2;
+            unsigned   kept  = total - moved;
+            for (unsigned i = 0; i < moved; ++i) {
+              right->keys[i].store(keys[kept + i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+              right->values[i].store(values[kept + i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            right->count.store(moved, std::memory_order_relaxed);
+            this->count.store(kept, std::memory_order_relaxed);
+            separator = keys[kept - 1].load(std::memory_order_relaxed);
+            return right;
+          }
+
+          // Inserts or overwrites; returns true if the key was new.
+          bool insert_or_assign(const Key& key, const Value& value) {
+            unsigned total = this->count.load(std::memory_order_relaxed);
+            unsigned pos   = lower_bound(keys, total, key);
+            if (pos < total && keys[pos].load(std::memory_order_relaxed) == key) {
+              values[pos].store(value, std::memory_order_relaxed);
+              return false;
+            }
+            for (unsigned i = total; i > pos; --i) {
+              keys[i].store(keys[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+              values[i].store(values[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            keys[pos].store(key, std::memory_order_relaxed);
+            values[pos].store(value, std::memory_order_relaxed);
+            this->count.store(total + 1, std::memory_order_relaxed);
+            return true;
+          }
+      };
+
+      std::atomic<node*> _root;
+
+      // First position among keys[0, count) whose key is >= `key`.
+      static unsigned lower_bound(const std::atomic<Key>* keys, unsigned count, const Key& key) noexcept {
+        unsigned low = 0;
+        unsigned high = count;
+        while (low < high) {
+          unsigned mid = low + (high - low) / 2;
+          if (keys[mid].load(std::memory_order_relaxed) < key) {
+            low = mid + 1;
+          } else {
+            high = mid;
+          }
+        }
+        return low;
+      }
+
+      // Node size from an optimistic read, clamped so a racing writer can never push a search out of bounds.
+      static unsigned clamped_count(const node* n, unsigned limit) noexcept {
+        unsigned count = n->count.load(std::memory_order_relaxed);
+        return count < limit ? count : limit;
+      }
+
+      static void destroy(node* n) noexcept {
+        if (n->is_leaf) {
+          delete static_cast<leaf_node*>(n);
+          return;
+        }
+        inner_node* inner = static_cast<inner_node*>(n);
+        for (unsigned i = 0; i <= inner->count.load(std::memory_order_relaxed); ++i) {
+          destroy(inner->children[i].load(std::memory_order_relaxed));
+        }
+        delete inner;
+      }
+
+      // Splits `full_node` (write-locked) under `parent` (write-locked, or nullptr for the root).
+      void split(node* full_node, inner_node* parent) {
+        Key   separator;
+        node* right = full_node->is_leaf ? static_cast<node*>(static_cast<leaf_node*>(full_node)->split(separator))
+                                         : static_cast<node*>(static_cast<inner_node*>(full_node)->split(separator));
+        if (parent) {
+          parent->insert(separator, right);
+          return;
+        }
+        inner_node* new_root = new inner_node();
+        new_root->keys[0].store(separator, std::memory_order_relaxed);
+        new_root->children[0].store(full_node, std::memory_order_relaxed);
+        new_root->children[1].store(right, std::memory_order_relaxed);
+        new_root->count.store(1, std::memory_order_relaxed);
+        _root.store(new_root, std::memory_order_release);
+      }
+
+      enum class attempt { done_inserted, done_assigned, restart };
+
+      attempt try_insert_or_assign(const Key& key, const Value& value) {
+        node*                        current = _root.load(std::memory_order_acquire);
+        std::optional<std::uint64_t> version = current->lock.read_begin_wait();
+        if (!version || _root.load(std::memory_order_acquire) != current) {
+          return attempt::restart;
+        }
+        inner_node*   parent         = nullptr;
+        std::uint64_t parent_version = 0;
+
+        while (!current->is_leaf) {
+          inner_node* inner = static_cast<inner_node*>(current);
+          if (inner->full()) {
+            // Split eagerly on the way down so the parent always has room for one more separator.
+            if (parent && !parent->lock.try_upgrade(parent_version)) {
+              return attempt::restart;
+            }
+            if (!inner->lock.try_upgrade(*version)) {
+              if (parent) {
+                parent->lock.unlock();
+              }
+              return attempt::restart;
+            }
+            if (!parent && _root.load(std::memory_order_relaxed) != inner) {
+              inner->lock.unlock();
+              return attempt::restart;
+            }
+            split(inner, parent);
+            inner->lock.unlock();
+            if (parent) {
+              parent->lock.unlock();
+            }
+            return attempt::restart;
+          }
+          if (parent && !parent->lock.validate(parent_version)) {
+            return attempt::restart;
+          }
+          parent         = inner;
+          parent_version = *version;
+
+          unsigned count = clamped_count(inner, NodeCapacity - 1);
+          current        = inner->children[lower_bound(inner->keys, count, key)].load(std::memory_order_acquire);
+          if (!inner->lock.validate(parent_version)) {
+            return attempt::restart;
+          }
+          version = current->lock.read_begin_wait();
+          if (!version) {
+            return attempt::restart;
+          }
+        }
+
+        leaf_node* leaf = static_cast<leaf_node*>(current);
+        if (leaf->full()) {
+          if (parent && !parent->lock.try_upgrade(parent_version)) {
+            return attempt::restart;
+          }
+          if (!leaf->lock.try_upgrade(*version)) {
+            if (parent) {
+              parent->lock.unlock();
+            }
+            return attempt::restart;
+          }
+          if (!parent && _root.load(std::memory_order_relaxed) != leaf) {
+            leaf->lock.unlock();
+            return attempt::restart;
+          }
+          split(leaf, parent);
+          leaf->lock.unlock();
+          if (parent) {
+            parent->lock.unlock();
+          }
+          return attempt::restart;
+        }
+        if (!leaf->lock.try_upgrade(*version)) {
+          return attempt::restart;
+        }
+        if (parent && !parent->lock.validate(parent_version)) {
+          leaf->lock.unlock();
+          return attempt::restart;
+        }
+        bool inserted = leaf->insert_or_assign(key, value);
+        leaf->lock.unlock();
+        return inserted ? attempt::done_inserted : attempt::done_assigned;
+      }
+
+    public:
+      olc_btree(): _root(new leaf_node()) { }
+
+      olc_btree(const olc_btree&)            = delete;
+      olc_btree& operator=(const olc_btree&) = delete;
+
+      ~olc_btree() { destroy(_root.load(std::memory_order_relaxed)); }
+
+      /**
+       * @brief Inserts `key` with `value`, or overwrites the value if `key` is present.
+       * @return True if the key was inserted, false if an existing value was overwritten.
+       */
+      bool insert_or_assign(const Key& key, const Value& value) {
+        while (true) {
+          attempt result = try_insert_or_assign(key, value);
+          if (result != attempt::restart) {
+            return result == attempt::done_inserted;
+          }
+        }
+      }
+
+      /**
+       * @brief Looks `key` up without writing to shared memory.
+       * @return A copy of the value, or `std::nullopt` if the key is absent.
+       */
+      std::optional<Value> find(const Key& key) const {
+      restart:
+        const node*                  current = _root.load(std::memory_order_acquire);
+        std::optional<std::uint64_t> version = current->lock.read_begin_wait();
+        if (!version || _root.load(std::memory_order_acquire) != current) {
+          goto restart;
+        }
+        while (!current->is_leaf) {
+          const inner_node* inner = static_cast<const inner_node*>(current);
+          unsigned          count = clamped_count(inner, NodeCapacity - 1);
+          const node*       child = inner->children[lower_bound(inner->keys, count, key)].load(std::memory_order_acquire);
+          if (!inner->lock.validate(*version)) {
+            goto restart;
+          }
+          std::optional<std::uint64_t> child_version = child->lock.read_begin_wait();
+          if (!child_version || !inner->lock.validate(*version)) {
+            goto restart;
+          }
+          current = child;
+          version = child_version;
+        }
+        const leaf_node*     leaf  = static_cast<const leaf_node*>(current);
+        unsigned             count = clamped_count(leaf, NodeCapacity);
+        unsigned             pos   = lower_bound(leaf->keys, count, key);
+        std::optional<Value> found;
+        if (pos < count && leaf->keys[pos].load(std::memory_order_relaxed) == key) {
+          found = leaf->values[pos].load(std::memory_order_relaxed);
+        }
+        if (!leaf->lock.validate(*version)) {
+          goto restart;
+        }
+        return found;
+      }
+
+      /// @brief Whether `key` is present.
+      bool contains(const Key& key) const { return find(key).has_value(); }
+  };
+}  // namespace rmutexpp
+#endif  // _OLC_BTREE_HEADER_
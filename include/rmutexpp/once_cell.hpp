@@ -0,0 +1,162 @@
+/**
+ * @file once_cell.hpp
+ * @brief Defines once_cell and rlazy, values initialized once by the first thread that
+ * needs them and read without locking afterwards.
+ *
+ * The pattern
+ *
+ * @code
+ * auto cache = lazy_index.lock();  // rmutex<std::optional<index>>
+ * if (!*cache) *cache = build_index();
+ * @endcode
+ *
+ * locks on every access, long after the value was built. `once_cell<T>::get_or_init(fn)`
+ * instead checks a state word with one acquire load and returns the value when it is
+ * ready. Only the first callers take the slow path: one of them runs `fn`, and the
+ * others park on the state word through C++20 `std::atomic::wait` (a futex on Linux)
+ * until it is done. If `fn` throws, the exception reaches its caller, the cell returns
+ * to empty and one of the parked threads retries.
+ */
+#ifndef _ONCE_CELL_HEADER_
+#define _ONCE_CELL_HEADER_
+
+#include <atomic>       // For std::atomic
+#include <cstdint>      // For std::uint32_t
+#include <functional>   // For std::invoke
+#include <memory>       // For std::addressof
+#include <new>          // For placement new
+#include <type_traits>  // For std::invoke_result_t, std::decay_t
+#include <utility>      // For std::forward, std::move
+
+namespace rmutexpp {
+
+  /**
+   * @class once_cell
+   * @brief A value written once, by whichever thread first calls `get_or_init()`.
+   * @tparam T The type of the value.
+   *
+   * The returned reference is shared by every thread: mutating the value needs its own
+   * synchronization, e.g. `once_cell<rmutex<T>>`.
+   *
+   * @code
+   * once_cell<config> settings;
+   * const config& current = settings.get_or_init([] { return load_config("app.toml"); });
+   * @endcode
+   */
+  template <typename T>
+  class once_cell {
+      static constexpr std::uint32_t empty        = 0;
+      static constexpr std::uint32_t running      = 1;
+      static constexpr std::uint32_t running_wait = 2;  ///< Running, and some thread is parked.
+      static constexpr std::uint32_t ready        = 3;
+
+      std::atomic<std::uint32_t> _state { empty };
+
+      union {
+          T _value;
+      };
+
+      template <typename Fn>
+      T& init_slow(Fn&& fn) {
+        std::uint32_t state = _state.load(std::memory_order_acquire);
+        while (true) {
+          if (state == ready) {
+            return _value;
+          }
+          if (state == empty) {
+            if (_state.compare_exchange_weak(state, running, std::memory_order_acquire, std::memory_order_acquire)) {
+              break;
+            }
+            continue;
+          }
+          // Someone else is initializing: announce ourselves and park until it finishes or fails.
+          if (state == running && !_state.compare_exchange_weak(state, running_wait, std::memory_order_acquire)) {
+            continue;
+          }
+          _state.wait(running_wait, std::memory_order_acquire);
+          state = _state.load(std::memory_order_acquire);
+        }
+        try {
+          ::new (static_cast<void*>(std::addressof(_value))) T(std::invoke(std::forward<Fn>(fn)));
+        } catch (...) {
+          if (_state.exchange(empty, std::memory_order_release) == running_wait) {
+            _state.notify_all();  // Every parked thread retries; one of them initializes.
+          }
+          throw;
+        }
+        if (_state.exchange(ready, std::memory_order_release) == running_wait) {
+          _state.notify_all();
+        }
+        return _value;
+      }
+
+    public:
+      constexpr once_cell() noexcept { }
+
+      once_cell(const once_cell&)            = delete;
+      once_cell& operator=(const once_cell&) = delete;
+
+      ~once_cell() {
+        if (_state.load(std::memory_order_acquire) == ready) {
+          _value.~T();
+        }
+      }
+
+      /**
+       * @brief Returns the value, initializing it from `fn()` if no thread has yet.
+       * @param fn Called with no arguments; its result constructs the value. It runs at
+       * most once successfully, and never concurrently with itself on the same cell.
+       * @return The value.
+       * @throws Whatever `fn` throws; the cell stays empty and the next caller retries.
+       */
+      template <typename Fn>
+        requires std::is_constructible_v<T, std::invoke_result_t<Fn>>
+      T& get_or_init(Fn&& fn) {
+        if (_state.load(std::memory_order_acquire) == ready) [[likely]] {
+          return _value;
+        }
+        return init_slow(std::forward<Fn>(fn));
+      }
+
+      /// @brief The value, or nullptr while the cell is empty or being initialized.
+      T* get() noexcept { return _state.load(std::memory_order_acquire) == ready ? std::addressof(_value) : nullptr; }
+
+      const T* get() const noexcept {
+        return _state.load(std::memory_order_acquire) == ready ? std::addressof(_value) : nullptr;
+      }
+  };
+
+  /**
+   * @class rlazy
+   * @brief A value computed by its initializer on first access, through a `once_cell`.
+   * @tparam T The type of the value.
+   * @tparam Init The initializer, callable with no arguments.
+   *
+   * @code
+   * rlazy primes([] { return sieve(1'000'000); });
+   * bool small_prime = primes->contains(97);  // The first access runs the sieve.
+   * @endcode
+   */
+  template <typename T, typename Init>
+  class rlazy {
+      Init         _init;
+      once_cell<T> _cell;
+
+    public:
+      constexpr explicit rlazy(Init init) noexcept(std::is_nothrow_move_constructible_v<Init>): _init(std::move(init)) { }
+
+      /// @brief The value, computed on the first call. @throws Whatever the initializer throws.
+      T& get() { return _cell.get_or_init(_init); }
+
+      T& operator*() { return get(); }
+
+      T* operator->() { return std::addressof(get()); }
+
+      /// @brief Whether the value has been computed.
+      bool initialized() const noexcept { return _cell.get() != nullptr; }
+  };
+
+  template <typename Init>
+  rlazy(Init) -> rlazy<std::decay_t<std::invoke_result_t<Init&>>, Init>;
+}  // namespace rmutexpp
+#endif  // _ONCE_CELL_HEADER_
@@ -0,0 +1,141 @@
+/**
+ * @file optimistic_lock.hpp
+ * @brief Defines optimistic_lock, a versioned lock for optimistic lock coupling (OLC).
+ *
+ * Readers never write the lock: they remember the version, read the protected data,
+ * and validate that the version is unchanged afterwards, retrying otherwise. Writers
+ * take the lock exclusively, either directly or by upgrading a version they read,
+ * which fails if anything changed since. This is the node lock of Leis et al.,
+ * "The ART of Practical Synchronization" (DaMoN 2016).
+ *
+ * The lock also models *Lockable*, so `rmutex<T, optimistic_lock>` works, but its
+ * purpose is to be embedded in the nodes of concurrent data structures such as
+ * `olc_btree`.
+ */
+#ifndef _OPTIMISTIC_LOCK_HEADER_
+#define _OPTIMISTIC_LOCK_HEADER_
+
+#include <atomic>     // For std::atomic, std::atomic_thread_fence
+#include <cstdint>    // For std::uint64_t
+#include <exception>  // For std::terminate
+#include <optional>   // For std::optional
+
+#include "rmutex_backends.hpp"  // For cpu_relax
+
+namespace rmutexpp {
+
+  /**
+   * @class optimistic_lock
+   * @brief A 64-bit version word: bit 0 marks the protected object obsolete, bit 1 marks it
+   * locked, and the remaining bits count completed write sections.
+   *
+   * Unlocking adds `0b10`, which clears the locked bit and carries into the counter in
+   * one step, so every write section produces a new, never repeated version.
+   *
+   * @code
+   * while (true) {
+   *   auto version = lock.read_begin();
+   *   if (!version) continue;                  // Locked or obsolete.
+   *   Value copy = shared_value.load(std::memory_order_relaxed);  // May be mid-write...
+   *   if (lock.validate(*version)) return copy;                   // ...which validation rejects.
+   * }
+   * @endcode
+   */
+  class optimistic_lock {
+      static constexpr std::uint64_t obsolete_bit = 0b01;
+      static constexpr std::uint64_t locked_bit   = 0b10;
+
+      std::atomic<std::uint64_t> _version { 0b100 };
+
+    public:
+      constexpr optimistic_lock() noexcept = default;
+
+      optimistic_lock(const optimistic_lock&)            = delete;
+      optimistic_lock& operator=(const optimistic_lock&) = delete;
+
+      /**
+       * @brief Starts an optimistic read.
+       * @return The current version, or `std::nullopt` if the lock is held or the object is obsolete.
+       */
+      std::optional<std::uint64_t> read_begin() const noexcept {
+        std::uint64_t version = _version.load(std::memory_order_acquire);
+        if (version & (locked_bit | obsolete_bit)) {
+          return std::nullopt;
+        }
+        return version;
+      }
+
+      /**
+       * @brief Like `read_begin()`, but spins while the lock is held.
+       * @return The version, or `std::nullopt` only if the object is obsolete.
+       */
+      std::optional<std::uint64_t> read_begin_wait() const noexcept {
+        std::uint64_t version = _version.load(std::memory_order_acquire);
+        while (version & locked_bit) {
+          cpu_relax();
+          version = _version.load(std::memory_order_acquire);
+        }
+        if (version & obsolete_bit) {
+          return std::nullopt;
+        }
+        return version;
+      }
+
+      /**
+       * @brief Checks that nothing was written since `read_begin()` returned `version`.
+       *
+       * The fence orders the optimistic reads of the protected data before the version
+       * check, so a successful validation means those reads saw a consistent state.
+       */
+      bool validate(std::uint64_t version) const noexcept {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return _version.load(std::memory_order_relaxed) == version;
+      }
+
+      /**
+       * @brief Turns an optimistic read into an exclusive lock if nothing changed since `version`.
+       * @return True if the lock is now held by the caller.
+       */
+      bool try_upgrade(std::uint64_t version) noexcept {
+        return _version.compare_exchange_strong(version, version + locked_bit, std::memory_order_acquire, std::memory_order_relaxed);
+      }
+
+      /**
+       * @brief Acquires the lock exclusively, spinning while it is held.
+       *
+       * An obsolete object can never be locked again, so locking one is a bug in the
+       * caller: it terminates instead of spinning forever.
+       */
+      void lock() noexcept {
+        while (true) {
+          std::optional<std::uint64_t> version = read_begin_wait();
+          if (!version) {
+            std::terminate();
+          }
+          if (try_upgrade(*version)) {
+            return;
+          }
+          cpu_relax();
+        }
+      }
+
+      /**
+       * @brief Attempts to acquire the lock exclusively without spinning.
+       * @return True if the lock was acquired.
+       */
+      bool try_lock() noexcept {
+        std::optional<std::uint64_t> version = read_begin();
+        return version && try_upgrade(*version);
+      }
+
+      /// @brief Releases the exclusive lock and publishes a new version.
+      void unlock() noexcept { _version.fetch_add(locked_bit, std::memory_order_release); }
+
+      /// @brief Releases the exclusive lock and marks the protected object obsolete for good.
+      void unlock_obsolete() noexcept { _version.fetch_add(locked_bit | obsolete_bit, std::memory_order_release); }
+
+      /// @brief Whether the lock is currently held exclusively.
+      bool is_locked() const noexcept { return (_version.load(std::memory_order_relaxed) & locked_bit) != 0; }
+  };
+}  // namespace rmutexpp
+#endif  // _OPTIMISTIC_LOCK_HEADER_
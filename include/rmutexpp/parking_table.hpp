@@ -0,0 +1,81 @@
+/**
+ * @file parking_table.hpp
+ * @brief Defines the process-wide parking table used by locks too small to wait on their
+ * own lock word.
+ *
+ * `std::atomic::wait` needs a whole atomic object to wait on, and a lock that lives in
+ * spare bits of another word (`pointer_rmutex`) cannot hand one out. Its waiters park on
+ * one of a fixed set of cache-line-sized buckets instead, chosen by hashing the lock's
+ * address. Each bucket holds an epoch counter: a waiter reads it, re-checks the lock
+ * word and waits for the epoch to move; an unlocker that saw the contended bit bumps
+ * the epoch and wakes the whole bucket. Locks that hash to the same bucket share wake-ups,
+ * which only costs a spurious re-check.
+ */
+#ifndef _PARKING_TABLE_HEADER_
+#define _PARKING_TABLE_HEADER_
+
+#include <atomic>   // For std::atomic
+#include <cstddef>  // For std::size_t
+#include <cstdint>  // For std::uint32_t, std::uint64_t, std::uintptr_t
+
+namespace rmutexpp {
+  namespace detail {
+    inline constexpr std::size_t parking_bucket_bits  = 8;
+    inline constexpr std::size_t parking_bucket_count = std::size_t { 1 } << parking_bucket_bits;
+
+    struct alignas(64) parking_bucket {
+        std::atomic<std::uint32_t> epoch { 0 };
+    };
+
+    inline parking_bucket parking_buckets[parking_bucket_count];
+
+    inline parking_bucket& parking_bucket_for(const void* address) noexcept {
+      // Fibonacci hashing of the address; the low bits are mostly alignment.
+      std::uint64_t key = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(address) >> 3);
+      return parking_buckets[(key * 0x9E3779B97F4A7C15ull) >> (64 - parking_bucket_bits)];
+    }
+
+    /// @brief The bucket epoch a waiter read before its last check of the lock state.
+    struct park_token {
+        parking_bucket* bucket;
+        std::uint32_t   epoch;
+    };
+
+    /**
+     * @brief First half of a two-step park: reads the epoch of the bucket of `address`.
+     *
+     * The caller re-checks its lock state after this and, if still blocked, calls
+     * `park(token)`. The read is sequentially consistent so that callers whose state
+     * lives in a different word than the bucket cannot miss an unpark in between.
+     */
+    inline park_token prepare_park(const void* address) noexcept {
+      parking_bucket& bucket = parking_bucket_for(address);
+      return { &bucket, bucket.epoch.load(std::memory_order_seq_cst) };
+    }
+
+    /// @brief Blocks until the bucket of `token` was unparked since `prepare_park()`. Returns spuriously.
+    inline void park(park_token token) noexcept { token.bucket->epoch.wait(token.epoch, std::memory_order_acquire); }
+
+    /**
+     * @brief Blocks the calling thread while `still_blocked()` holds, until `unpark_all(address)`.
+     *
+     * `still_blocked` runs after the epoch was read, so an unpark that happens between the
+     * check and the wait is never lost. Returns spuriously; callers loop.
+     */
+    template <typename Predicate>
+    void park(const void* address, Predicate still_blocked) {
+      park_token token = prepare_park(address);
+      if (still_blocked()) {
+        park(token);
+      }
+    }
+
+    /// @brief Wakes every thread parked on the bucket of `address`.
+    inline void unpark_all(const void* address) noexcept {
+      parking_bucket& bucket = parking_bucket_for(address);
+      bucket.epoch.fetch_add(1, std::memory_order_seq_cst);
+      bucket.epoch.notify_all();
+    }
+  }  // namespace detail
+}  // namespace rmutexpp
+#endif  // _PARKING_TABLE_HEADER_
@@ -0,0 +1,250 @@
+/**
+ * @file pointer_rmutex.hpp
+ * @brief Defines pointer_rmutex, a pointer guarded by a lock that lives in the pointer's
+ * own spare low bits, so the whole rmutex is the size of a pointer.
+ *
+ * `rmutex<Node*>` pays for a full lock next to an 8-byte pointer, which rules it out for
+ * locking the individual slots of huge pointer arrays (hash buckets, per-page tables).
+ * Pointers to types aligned to at least 4 bytes have two free low bits. `pointer_rmutex`
+ * keeps the lock bit and a contended bit there, in the spirit of folly's PicoSpinLock:
+ *
+ * | pointer bits | contended (bit 1) | locked (bit 0) |
+ *
+ * Waiters spin briefly and then park on the process-wide parking table of
+ * `parking_table.hpp`, since a lock inside another word cannot be waited on directly.
+ *
+ * An `rmutex<T*>` hands out `T*&`, which cannot point into a word that also carries lock
+ * bits. `pointer_rmutex` is therefore its own type, with a ref that reads the pointer with
+ * `get()` and changes it with `set()` (raw pointers) or `exchange()` (`std::unique_ptr`).
+ */
+#ifndef _POINTER_RMUTEX_HEADER_
+#define _POINTER_RMUTEX_HEADER_
+
+#include <atomic>       // For std::atomic
+#include <cstdint>      // For std::uintptr_t
+#include <memory>       // For std::unique_ptr, std::pointer_traits
+#include <optional>     // For std::optional
+#include <type_traits>  // For std::is_same_v
+#include <utility>      // For std::exchange, std::move
+
+#include "parking_table.hpp"    // For detail::park, detail::unpark_all
+#include "rmutex_backends.hpp"  // For cpu_relax
+
+namespace rmutexpp {
+  namespace detail {
+    /**
+     * @brief A pointer word whose two low bits are a lock. All accessors of the pointer
+     * part assume the lock is held by the caller.
+     */
+    class pointer_lock_word {
+        static constexpr std::uintptr_t locked     = 1;
+        static constexpr std::uintptr_t contended  = 2;
+        static constexpr std::uintptr_t lock_bits  = locked | contended;
+        static constexpr unsigned       spin_limit = 100;
+
+        std::atomic<std::uintptr_t> _word { 0 };
+
+        void lock_slow() noexcept {
+          for (unsigned spins = 0; spins < spin_limit; ++spins) {
+            std::uintptr_t current = _word.load(std::memory_order_relaxed);
+            if (!(current & locked) &&
+                _word.compare_exchange_weak(current, current | locked, std::memory_order_acquire, std::memory_order_relaxed)) {
+              return;
+            }
+            cpu_relax();
+          }
+          std::uintptr_t current = _word.load(std::memory_order_relaxed);
+          while (true) {
+            if (!(current & locked)) {
+              // Having parked, assume others still are: the next unlock wakes the bucket.
+              if (_word.compare_exchange_weak(current, current | lock_bits, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;
+              }
+              continue;
+            }
+            if (!(current & contended) &&
+                !_word.compare_exchange_weak(current, current | contended, std::memory_order_relaxed, std::memory_order_relaxed)) {
+              continue;
+            }
+            park(this, [&] { return (_word.load(std::memory_order_relaxed) & lock_bits) == lock_bits; });
+            current = _word.load(std::memory_order_relaxed);
+          }
+        }
+
+      public:
+        constexpr pointer_lock_word() noexcept = default;
+
+        explicit pointer_lock_word(const void* pointer) noexcept: _word(reinterpret_cast<std::uintptr_t>(pointer)) { }
+
+        void lock() noexcept {
+          std::uintptr_t current = _word.load(std::memory_order_relaxed);
+          if (current & locked ||
+              !_word.compare_exchange_weak(current, current | locked, std::memory_order_acquire, std::memory_order_relaxed)) {
+            lock_slow();
+          }
+        }
+
+        bool try_lock() noexcept {
+          std::uintptr_t current = _word.load(std::memory_order_relaxed);
+          return !(current & locked) &&
+                 _word.compare_exchange_strong(current, current | locked, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+
+        void unlock() noexcept {
+          if (_word.fetch_and(~lock_bits, std::memory_order_release) & contended) {
+            unpark_all(this);
+          }
+        }
+
+        void* pointer() const noexcept { return reinterpret_cast<void*>(_word.load(std::memory_order_relaxed) & ~lock_bits); }
+
+        /// @brief Replaces the pointer, keeping the lock bits (waiters may set the contended bit meanwhile).
+        void store(const void* pointer) noexcept {
+          std::uintptr_t bits    = reinterpret_cast<std::uintptr_t>(pointer);
+          std::uintptr_t current = _word.load(std::memory_order_relaxed);
+          while (!_word.compare_exchange_weak(current, bits | (current & lock_bits), std::memory_order_relaxed, std::memory_order_relaxed)) { }
+        }
+    };
+  }  // namespace detail
+
+  template <typename P>
+  class pointer_rmutex;
+
+  /**
+   * @class pointer_rmutex_ref
+   * @brief Scoped access to the pointer of a `pointer_rmutex`; the lock is released on destruction.
+   * @tparam P The pointer type, `T*` or `std::unique_ptr<T>`.
+   */
+  template <typename P>
+  class pointer_rmutex_ref {
+      using element_type = typename std::pointer_traits<P>::element_type;
+
+      detail::pointer_lock_word* _word;  ///< Null once moved from.
+
+      explicit pointer_rmutex_ref(detail::pointer_lock_word& word) noexcept: _word(&word) { }
+
+      friend class pointer_rmutex<P>;
+
+    public:
+      pointer_rmutex_ref(pointer_rmutex_ref&& other) noexcept: _word(std::exchange(other._word, nullptr)) { }
+
+      pointer_rmutex_ref& operator=(pointer_rmutex_ref&& other) noexcept {
+        if (this != &other) {
+          if (_word) {
+            _word->unlock();
+          }
+          _word = std::exchange(other._word, nullptr);
+        }
+        return *this;
+      }
+
+      ~pointer_rmutex_ref() {
+        if (_word) {
+          _word->unlock();
+        }
+      }
+
+      /// @brief Whether this ref holds the lock (false once moved from).
+      bool owns() const noexcept { return _word != nullptr; }
+
+      /// @brief The guarded pointer. @pre `owns()`.
+      element_type* get() const noexcept { return static_cast<element_type*>(_word->pointer()); }
+
+      element_type& operator*() const noexcept { return *get(); }
+
+      element_type* operator->() const noexcept { return get(); }
+
+      /// @brief Points the rmutex somewhere else. @pre `owns()`.
+      void set(element_type* pointer) noexcept
+        requires std::is_same_v<P, element_type*>
+      {
+        _word->store(pointer);
+      }
+
+      /**
+       * @brief Replaces the owned object, handing the previous one back to the caller.
+       * @pre `owns()`.
+       */
+      [[nodiscard]] std::unique_ptr<element_type> exchange(std::unique_ptr<element_type> pointer) noexcept
+        requires std::is_same_v<P, std::unique_ptr<element_type>>
+      {
+        std::unique_ptr<element_type> previous(get());
+        _word->store(pointer.release());
+        return previous;
+      }
+  };
+
+  /**
+   * @class pointer_rmutex
+   * @brief A pointer and its lock in a single word: `sizeof(pointer_rmutex<T*>) == sizeof(T*)`.
+   * @tparam P `T*` (not owning) or `std::unique_ptr<T>` (owning, with the default deleter).
+   * `T` must be aligned to at least 4 bytes.
+   *
+   * @code
+   * std::vector<pointer_rmutex<node*>> buckets(1 << 20);  // 8 MiB: one word per bucket
+   * {
+   *   auto head = buckets[hash(key) & mask].lock();
+   *   head.set(new node { key, value, head.get() });
+   * }
+   * @endcode
+   */
+  template <typename P>
+  class pointer_rmutex {
+      using element_type = typename std::pointer_traits<P>::element_type;
+
+      static_assert(std::is_same_v<P, element_type*> || std::is_same_v<P, std::unique_ptr<element_type>>,
+                    "pointer_rmutex holds a raw pointer or a std::unique_ptr with the default deleter.");
+      static_assert(alignof(element_type) >= 4, "pointer_rmutex needs two free low bits in the pointer.");
+
+      static constexpr bool owning = !std::is_same_v<P, element_type*>;
+
+      detail::pointer_lock_word _word;
+
+      static element_type* adopt(P pointer) noexcept {
+        if constexpr (owning) {
+          return pointer.release();
+        } else {
+          return pointer;
+        }
+      }
+
+    public:
+      /// @brief A null pointer.
+      constexpr pointer_rmutex() noexcept = default;
+
+      /// @brief Guards `pointer`; a `std::unique_ptr` is adopted.
+      explicit pointer_rmutex(P pointer) noexcept: _word(adopt(std::move(pointer))) { }
+
+      /// @brief Takes the pointer of `other` under its lock, leaving `other` null.
+      pointer_rmutex(pointer_rmutex&& other) noexcept {
+        other._word.lock();
+        _word.store(other._word.pointer());
+        other._word.store(nullptr);
+        other._word.unlock();
+      }
+
+      pointer_rmutex(const pointer_rmutex&)            = delete;
+      pointer_rmutex& operator=(const pointer_rmutex&) = delete;
+
+      ~pointer_rmutex() {
+        if constexpr (owning) {
+          delete static_cast<element_type*>(_word.pointer());
+        }
+      }
+
+      /// @brief Locks the word and returns the scoped access to the pointer.
+      [[nodiscard]] pointer_rmutex_ref<P> lock() noexcept {
+        _word.lock();
+        return pointer_rmutex_ref<P>(_word);
+      }
+
+      /// @brief Attempts to lock the word without blocking.
+      [[nodiscard]] std::optional<pointer_rmutex_ref<P>> try_lock() noexcept {
+        if (!_word.try_lock()) {
+          return std::nullopt;
+        }
+        return pointer_rmutex_ref<P>(_word);
+      }
+  };
+}  // namespace rmutexpp
+#endif  // _POINTER_RMUTEX_HEADER_
@@ -0,0 +1,370 @@
+/**
+ * @file range_rmutex.hpp
+ * @brief Defines range_rmutex, an rmutex-like wrapper over a contiguous container whose
+ * locks cover index ranges instead of the whole container, and range_rmutex_ref, the
+ * RAII reference to a locked sub-span.
+ *
+ * Writers that touch disjoint `[begin, end)` index ranges of the same container proceed
+ * in parallel; overlapping ranges exclude each other. The held ranges are tracked in a
+ * lock-free list sorted by start index, following the list-based range lock of Kogan,
+ * Dice and Issa ("Scalable Range Locks for Scalable Address Spaces and Beyond",
+ * EuroSys 2020). Acquiring a range announces the thread's epoch in its own slot, walks
+ * the list and links a node with one compare-and-swap; the node comes from a per-thread
+ * pool, so steady-state acquisitions do not allocate. Releasing is a single atomic OR
+ * that marks the node, plus a wake-up only when a thread waits on it. Marked nodes are
+ * unlinked by whichever thread passes by next and recycled through epoch-based
+ * reclamation (`epoch_reclamation.hpp`) once no traversal can reach them. No counter or
+ * list shared by all ranges is written besides the list links themselves, but threads
+ * do contend on the links of neighboring ranges.
+ *
+ * @note The container itself is never resized through a range_rmutex: only its elements
+ * are reachable, through `std::span`s of the locked ranges.
+ */
+#ifndef _RANGE_RMUTEX_HEADER_
+#define _RANGE_RMUTEX_HEADER_
+
+#include <atomic>    // For std::atomic
+#include <cstddef>   // For std::size_t
+#include <cstdint>   // For std::uintptr_t
+#include <iterator>  // For std::ranges::data, std::ranges::size
+#include <optional>  // For std::optional
+#include <ranges>    // For std::ranges::contiguous_range, std::ranges::sized_range
+#include <span>      // For std::span
+#include <utility>   // For std::forward, std::exchange
+
+#include "epoch_reclamation.hpp"  // For detail::epoch_guard, detail::epoch_retired
+#include "parking_table.hpp"      // For detail::park, detail::prepare_park, detail::unpark_all
+
+namespace rmutexpp {
+  namespace detail {
+    /**
+     * @class range_lock
+     * @brief Exclusive range lock over half-open index ranges.
+     *
+     * Every held range is a node of a singly linked list sorted by `begin`. The two low
+     * bits of a node's `next` word describe the node itself: `released_bit` marks it as
+     * released, `waited_bit` records that a thread sleeps until it is. A released `next`
+     * also makes every compare-and-swap that would insert behind the node fail, which is
+     * what keeps insertions from racing with unlinking. Traversals run under an
+     * `epoch_guard`, so unlinked nodes are retired to the epoch domain and recycled into
+     * a per-thread node pool only once no traversal can still reach them.
+     */
+    class range_lock {
+        struct node: epoch_retired {
+            std::size_t                 begin = 0;
+            std::size_t                 end   = 0;
+            std::atomic<std::uintptr_t> next { 0 };
+        };
+
+        static constexpr std::uintptr_t released_bit = 1;
+        static constexpr std::uintptr_t waited_bit   = 2;
+        static constexpr std::uintptr_t flag_bits    = released_bit | waited_bit;
+        static constexpr unsigned       pool_limit   = 64;
+
+        struct node_pool {
+            node*    free  = nullptr;
+            unsigned count = 0;
+
+            ~node_pool() {
+              while (free) {
+                delete std::exchange(free, static_cast<node*>(free->retired_next));
+              }
+            }
+        };
+
+        std::atomic<std::uintptr_t> _head { 0 };  ///< The first node; its flag bits stay clear.
+
+        static node_pool& this_thread_pool() noexcept {
+          thread_local node_pool pool;
+          return pool;
+        }
+
+        static node* make_node(std::size_t begin, std::size_t end) {
+          node_pool& pool  = this_thread_pool();
+          node*      fresh = pool.free;
+          if (fresh) {
+            pool.free = static_cast<node*>(fresh->retired_next);
+            --pool.count;
+          } else {
+            fresh          = new node;
+            fresh->reclaim = &recycle;
+          }
+          fresh->begin = begin;
+          fresh->end   = end;
+          fresh->next.store(0, std::memory_order_relaxed);
+          return fresh;
+        }
+
+        static void recycle(epoch_retired* retired) noexcept {
+          node_pool& pool = this_thread_pool();
+          if (pool.count == pool_limit) {
+            delete static_cast<node*>(retired);
+            return;
+          }
+          retired->retired_next = pool.free;
+          pool.free             = static_cast<node*>(retired);
+          ++pool.count;
+        }
+
+        static node* as_node(std::uintptr_t word) noexcept { return reinterpret_cast<node*>(word & ~flag_bits); }
+
+        static bool is_released(std::uintptr_t word) noexcept { return (word & released_bit) != 0; }
+
+        /**
+         * Inserts `fresh` once no held range overlaps it. On overlap, gives up if `wait` is
+         * null; otherwise flags the overlapping node as waited on, fills `wait` for
+         * `park()` and returns false, so that the caller sleeps outside of its epoch.
+         */
+        bool insert(node* fresh, epoch_guard& guard, park_token* wait) noexcept {
+        restart:
+          std::atomic<std::uintptr_t>* prev = &_head;
+          std::uintptr_t               cur  = prev->load(std::memory_order_seq_cst);
+          while (true) {
+            if (is_released(cur)) {
+              // The predecessor was released under our feet; its link may be unlinked next.
+              goto restart;
+            }
+            node* current = as_node(cur);
+            if (current) {
+              std::uintptr_t next = current->next.load(std::memory_order_seq_cst);
+              if (is_released(next)) {
+                // Help unlink the released node, keeping the predecessor's own flags; on
+                // failure `cur` is refreshed and re-examined.
+                std::uintptr_t successor = (next & ~flag_bits) | (cur & waited_bit);
+                if (prev->compare_exchange_strong(cur, successor, std::memory_order_seq_cst)) {
+                  guard.retire(current);
+                  cur = successor;
+                }
+                continue;
+              }
+              if (current->end <= fresh->begin) {
+                prev = &current->next;
+                cur  = next;
+                continue;
+              }
+              if (fresh->end > current->begin) {
+                if (!wait) {
+                  return false;
+                }
+                if (!(next & waited_bit) &&
+                    !current->next.compare_exchange_strong(next, next | waited_bit, std::memory_order_seq_cst)) {
+                  continue;
+                }
+                // Read the bucket before the last check: a release after it bumps the bucket.
+                *wait = prepare_park(current);
+                if (is_released(current->next.load(std::memory_order_seq_cst))) {
+                  continue;
+                }
+                return false;
+              }
+            }
+            // Every node from here on starts at or after our end: link in front of `current`.
+            fresh->next.store(cur & ~flag_bits, std::memory_order_relaxed);
+            if (prev->compare_exchange_strong(cur, reinterpret_cast<std::uintptr_t>(fresh) | (cur & waited_bit),
+                                              std::memory_order_seq_cst)) {
+              return true;
+            }
+          }
+        }
+
+      public:
+        /// @brief Opaque handle of a held range, released with `release()`.
+        using handle = node*;
+
+        constexpr range_lock() noexcept = default;
+
+        range_lock(const range_lock&)            = delete;
+        range_lock& operator=(const range_lock&) = delete;
+
+        /// @brief Frees the released nodes still linked; unlinked ones belong to the epoch domain.
+        ~range_lock() {
+          node* current = as_node(_head.load());
+          while (current) {
+            delete std::exchange(current, as_node(current->next.load()));
+          }
+        }
+
+        /**
+         * @brief Acquires `[begin, end)`, blocking while an overlapping range is held.
+         * @return The handle to pass to `release()`.
+         */
+        handle acquire(std::size_t begin, std::size_t end) {
+          node* fresh = make_node(begin, end);
+          while (true) {
+            park_token token {};
+            {
+              epoch_guard guard;
+              if (insert(fresh, guard, &token)) {
+                return fresh;
+              }
+            }
+            park(token);
+          }
+        }
+
+        /**
+         * @brief Acquires `[begin, end)` only if no overlapping range is currently held.
+         * @return The handle to pass to `release()`, or `nullptr` on failure.
+         */
+        handle try_acquire(std::size_t begin, std::size_t end) {
+          node*       fresh = make_node(begin, end);
+          epoch_guard guard;
+          if (!insert(fresh, guard, nullptr)) {
+            recycle(fresh);
+            return nullptr;
+          }
+          return fresh;
+        }
+
+        /**
+         * @brief Releases a range obtained from `acquire()` or `try_acquire()`.
+         *
+         * Only marks the node: it stays linked, and therefore allocated, until a later
+         * traversal unlinks it, so no epoch needs to be entered.
+         */
+        void release(handle held) noexcept {
+          if (held->next.fetch_or(released_bit, std::memory_order_seq_cst) & waited_bit) {
+            unpark_all(held);
+          }
+        }
+    };
+  }  // namespace detail
+
+  template <typename Container>
+    requires std::ranges::contiguous_range<Container> && std::ranges::sized_range<Container>
+  class range_rmutex;
+
+  /**
+   * @class range_rmutex_ref
+   * @brief A RAII reference to a locked sub-span of a range_rmutex.
+   * @tparam T The element type of the protected container.
+   *
+   * Behaves like a `std::span<T>` over the locked range (indexing, iteration, `size()`)
+   * and releases the range when destroyed. Like rmutex_ref it is move-only.
+   */
+  template <typename T>
+  class range_rmutex_ref {
+      std::span<T>              _elements;
+      detail::range_lock*         _lock;
+      detail::range_lock::handle _held;
+
+      range_rmutex_ref(std::span<T> elements, detail::range_lock& lock, detail::range_lock::handle held) noexcept:
+          _elements(elements), _lock(&lock), _held(held) { }
+
+      template <typename Container>
+        requires std::ranges::contiguous_range<Container> && std::ranges::sized_range<Container>
+      friend class range_rmutex;
+
+    public:
+      /// @brief Releases the locked range.
+      ~range_rmutex_ref() {
+        if (_held) {
+          _lock->release(std::exchange(_held, nullptr));
+        }
+      }
+
+      range_rmutex_ref(range_rmutex_ref&& other) noexcept:
+          _elements(other._elements), _lock(other._lock), _held(std::exchange(other._held, nullptr)) { }
+
+      range_rmutex_ref& operator=(range_rmutex_ref&& other) noexcept {
+        if (this != &other) {
+          if (_held) {
+            _lock->release(_held);
+          }
+          _elements = other._elements;
+          _lock     = other._lock;
+          _held     = std::exchange(other._held, nullptr);
+        }
+        return *this;
+      }
+
+      range_rmutex_ref(const range_rmutex_ref&)            = delete;
+      range_rmutex_ref& operator=(const range_rmutex_ref&) = delete;
+
+      /// @brief The locked elements.
+      std::span<T> span() const& noexcept { return _elements; }
+
+      /// @brief Element `index` of the locked range (relative to its start).
+      T& operator[](std::size_t index) const noexcept { return _elements[index]; }
+
+      std::size_t size() const noexcept { return _elements.size(); }
+
+      auto begin() const noexcept { return _elements.begin(); }
+
+      auto end() const noexcept { return _elements.end(); }
+
+      /// @brief Deleted rvalue version of span() to prevent the span from outliving the lock.
+      std::span<T> span() const&& = delete;
+  };
+
+  /**
+   * @class range_rmutex
+   * @brief Protects a contiguous container with locks over index ranges.
+   * @tparam Container A contiguous, sized container such as `std::vector<Record>` or `std::array`.
+   *
+   * `lock(begin, end)` blocks until no overlapping range is held and returns a
+   * `range_rmutex_ref` exposing only `[begin, end)`. Non-overlapping ranges are held
+   * concurrently. Like rmutex it is not copyable; unlike rmutex it is also not movable,
+   * because held ranges point into it.
+   *
+   * @code
+   * range_rmutex<std::vector<Record>> records { 1'000'000 };
+   * {
+   *   auto slice = records.lock(1000, 2000);  // Other threads may lock [0, 1000) meanwhile.
+   *   for (Record& r : slice) { r.update(); }
+   * }
+   * @endcode
+   */
+  template <typename Container>
+    requires std::ranges::contiguous_range<Container> && std::ranges::sized_range<Container>
+  class range_rmutex {
+      using element_type = std::remove_reference_t<std::ranges::range_reference_t<Container>>;
+
+      detail::range_lock _ranges;  ///< The held ranges.
+
+      Container _internal_data;  ///< The protected container.
+
+      std::span<element_type> slice(std::size_t begin, std::size_t end) noexcept {
+        return std::span<element_type>(std::ranges::data(_internal_data) + begin, end - begin);
+      }
+
+    public:
+      /**
+       * @brief Constructs the protected container from the provided arguments.
+       * @param args Arguments forwarded to the constructor of `Container`.
+       */
+      template <typename... Args>
+      explicit range_rmutex(Args&&... args): _internal_data(std::forward<Args>(args)...) { }
+
+      range_rmutex(const range_rmutex&)            = delete;
+      range_rmutex& operator=(const range_rmutex&) = delete;
+
+      /// @brief The number of elements of the protected container.
+      std::size_t size() const noexcept { return std::ranges::size(_internal_data); }
+
+      /**
+       * @brief Locks the index range `[begin, end)`, blocking while an overlapping range is held.
+       * @pre `begin <= end && end <= size()`.
+       * @return A reference exposing exactly the locked elements.
+       */
+      [[nodiscard]] range_rmutex_ref<element_type> lock(std::size_t begin, std::size_t end) {
+        return range_rmutex_ref<element_type>(slice(begin, end), _ranges, _ranges.acquire(begin, end));
+      }
+
+      /**
+       * @brief Attempts to lock `[begin, end)` without blocking.
+       * @pre `begin <= end && end <= size()`.
+       * @return The reference, or `std::nullopt` if an overlapping range is held.
+       */
+      [[nodiscard]] std::optional<range_rmutex_ref<element_type>> try_lock(std::size_t begin, std::size_t end) {
+        if (detail::range_lock::handle held = _ranges.try_acquire(begin, end)) {
+          return range_rmutex_ref<element_type>(slice(begin, end), _ranges, held);
+        }
+        return std::nullopt;
+      }
+
+      /// @brief Locks every element; equivalent to `lock(0, size())`.
+      [[nodiscard]] range_rmutex_ref<element_type> lock_all() { return lock(0, size()); }
+  };
+}  // namespace rmutexpp
+#endif  // _RANGE_RMUTEX_HEADER_
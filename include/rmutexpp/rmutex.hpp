@@ -13,17 +13,143 @@
 #ifndef _RUST_MUTEX_HEADER_
 #define _RUST_MUTEX_HEADER_
 
+#include <concepts>
+#include <functional>
 #include <mutex>
 #include <optional>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+
+#include "deferred_destruction.hpp"  // For detail::defer_destruction, detail::flush_deferred, background_reclaimer
+#include "single_threaded.hpp"       // For RMUTEX_ASSERT
 #ifdef DEBUG_RMUTEX
 #include <iostream>
 #endif
 
+/**
+ * @def RMUTEX_ALWAYS_INLINE
+ * @brief Forces inlining of the lambda-based critical sections (`with_lock`, `with_locks`),
+ * so the lock, the callable and the unlock compile into the caller as one block.
+ */
+#if defined(_MSC_VER)
+#define RMUTEX_ALWAYS_INLINE __forceinline
+#else
+#define RMUTEX_ALWAYS_INLINE inline __attribute__((always_inline))
+#endif
+
 namespace rmutexpp {
 
-  // Forward declaration so we can use the template in the trait
+  /**
+   * @concept rmutex_lockable
+   * @brief The requirements on the lock backend of an rmutex: the standard *Lockable* interface.
+   * @tparam M The candidate backend type (e.g. `std::mutex`, `spin_mutex`, `word_mutex`).
+   */
+  template <typename M>
+  concept rmutex_lockable = requires(M& m) {
+    m.lock();
+    m.unlock();
+    { m.try_lock() } -> std::convertible_to<bool>;
+  };
+
+  /**
+   * @concept freezable_lockable
+   * @brief Lock backends that can be frozen (e.g. `freezable_mutex`), which `rmutex::freeze()` and `rmutex::read()` need.
+   * @tparam M The candidate backend type.
+   */
+  template <typename M>
+  concept freezable_lockable = rmutex_lockable<M> && requires(M& m, const M& cm) {
+    m.freeze();
+    { cm.frozen() } -> std::convertible_to<bool>;
+  };
+
+  namespace detail {
+    // Viable only when `M()` is a constant expression.
+    template <typename M, bool = (M(), true)>
+    constexpr bool constant_initializable_probe(int) {
+      return true;
+    }
+
+    template <typename M>
+    constexpr bool constant_initializable_probe(...) {
+      return false;
+    }
+
+    // Goes through a variable template: GCC does not evaluate the probe call reliably inside a constraint.
+    template <typename M>
+    inline constexpr bool is_constant_initializable = constant_initializable_probe<M>(0);
+  }  // namespace detail
+
+  /**
+   * @concept constant_initializable_lockable
+   * @brief Lock backends that can be initialized at compile time, which `constinit rmutex` needs.
+   *
+   * `std::mutex`, `spin_mutex`, `word_mutex` and `optimistic_lock` all qualify.
+   * @tparam M The candidate backend type.
+   */
+  template <typename M>
+  concept constant_initializable_lockable = rmutex_lockable<M> && detail::is_constant_initializable<M>;
+
+  /**
+   * @struct intrusive_lock
+   * @brief Lock backend tag for an rmutex whose lock is a data member of `T` itself.
+   *
+   * The rmutex stores nothing but `T`; locking goes through the member named by
+   * `intrusive_lock_traits<T>`. See `intrusive_rmutex`.
+   */
+  struct intrusive_lock { };
+
+  /**
+   * @struct intrusive_lock_traits
+   * @brief Names the lock member of `T` for `intrusive_rmutex<T>`.
+   * @tparam T The payload type.
+   *
+   * By default the lock is the data member `T::rmutex_lock`. Specialize the trait to use
+   * another member:
+   *
+   * @code
+   * template <>
+   * struct rmutexpp::intrusive_lock_traits<packet> {
+   *   static constexpr auto member = &packet::guard;
+   * };
+   * @endcode
+   */
   template <typename T>
+  struct intrusive_lock_traits {
+      static constexpr auto member = &T::rmutex_lock;
+  };
+
+  namespace detail {
+    template <typename M>
+    struct member_pointee;
+
+    template <typename C, typename M>
+    struct member_pointee<M C::*> {
+        using type = M;
+    };
+
+    // The object an rmutex<T, Mutex> actually locks: Mutex itself, or the lock member of T.
+    template <typename T, typename Mutex>
+    struct rmutex_lock_type {
+        using type = Mutex;
+    };
+
+    template <typename T>
+    struct rmutex_lock_type<T, intrusive_lock> {
+        using type = typename member_pointee<std::remove_cv_t<decltype(intrusive_lock_traits<T>::member)>>::type;
+    };
+  }  // namespace detail
+
+  /**
+   * @concept rmutex_backend
+   * @brief What may be passed as the `Mutex` parameter of an rmutex: a lockable type, or `intrusive_lock`.
+   */
+  template <typename M>
+  concept rmutex_backend = rmutex_lockable<M> || std::same_as<M, intrusive_lock>;
+
+  // Forward declaration so we can use the template in the trait
+  template <typename T, typename Mutex = std::mutex>
+    requires rmutex_backend<Mutex>
   class rmutex;
 
   /**
@@ -43,15 +169,16 @@ namespace rmutexpp {
   template <typename>
   struct is_rmutex : std::false_type { };
   /**
-   * @struct is_rmutex<rmutex<T>>
-   * @brief Partial specialization of `is_rmutex` for `rmutex<T>`.
+   * @struct is_rmutex<rmutex<T, Mutex>>
+   * @brief Partial specialization of `is_rmutex` for `rmutex<T, Mutex>`.
    * @tparam T The data type encapsulated by `rmutex`.
+   * @tparam Mutex The lock backend of the `rmutex`.
    *
    * This specialization inherits from `std::true_type`, indicating that the
-   * checked type `rmutex<T>` is indeed a specialization of `rmutex`.
+   * checked type `rmutex<T, Mutex>` is indeed a specialization of `rmutex`.
    */
-  template <typename T>
-  struct is_rmutex<rmutex<T>> : std::true_type { };
+  template <typename T, typename Mutex>
+  struct is_rmutex<rmutex<T, Mutex>> : std::true_type { };
   /**
    * @var all_are_rmutex
    * @brief A convenience variable template to check if all types in a variadic pack are `rmutex` specializations.
@@ -93,9 +220,10 @@ namespace rmutexpp {
   template <typename>
   struct rmutex_data_type;  // no definition: gives an error for invalid types
   /**
-   * @struct rmutex_data_type<rmutex<T>>
-   * @brief Partial specialization of `rmutex_data_type` for `rmutex<T>`.
+   * @struct rmutex_data_type<rmutex<T, Mutex>>
+   * @brief Partial specialization of `rmutex_data_type` for `rmutex<T, Mutex>`.
    * @tparam T The data type encapsulated by `rmutex`.
+   * @tparam Mutex The lock backend of the `rmutex`.
    *
    * Provides a `using type = T;` member, which aliases the internal data type `T`
    * of the `rmutex` specialization.
@@ -104,8 +232,8 @@ namespace rmutexpp {
    * static_assert(std::is_same_v<rmutex_data_type<rmutex<double>>::type, double>, "Should be true");
    * @endcode
    */
-  template <typename T>
-  struct rmutex_data_type<rmutex<T>> {
+  template <typename T, typename Mutex>
+  struct rmutex_data_type<rmutex<T, Mutex>> {
       using type = T;
   };
   /**
@@ -123,11 +251,16 @@ namespace rmutexpp {
   template <typename T>
   using rmutex_data_type_t = typename rmutex_data_type<T>::type;
 
+  /**
+   * @struct rmutex_mutex_type
+   * @brief Type trait to extract the lock backend from an `rmutex<T, Mutex>` specialization.
+   * @tparam U The `rmutex` specialization.
+   */
   template <typename T>
   struct rmutex_mutex_type;
-  template <typename T>
-  struct rmutex_mutex_type<rmutex<T>> {
-      using type = std::mutex;
+  template <typename T, typename Mutex>
+  struct rmutex_mutex_type<rmutex<T, Mutex>> {
+      using type = Mutex;
   };
   template <typename T>
   using rmutex_mutex_type_t = typename rmutex_mutex_type<T>::type;
@@ -139,27 +272,45 @@ namespace rmutexpp {
   class rmutex_guard;
 
   // Forward declaration for class friend declaration.
-  template <typename T>
+  template <typename T, typename Mutex = std::mutex>
   class rmutex_ref;
 
+  namespace detail {
+    // Grants the free functions of this library (e.g. with_locks) access to an rmutex's members.
+    struct rmutex_access;
+  }  // namespace detail
+
   /**
    * @class rmutex
    * @brief A thread-safe wrapper that protects a single piece of mutable data with a mutex.
    * @tparam T The type of data to be protected.
+   * @tparam Mutex The lock backend, `std::mutex` by default. Any type satisfying
+   * `rmutex_lockable` works, such as the backends of `rmutex_backends.hpp`, as does
+   * `intrusive_lock` (see `intrusive_rmutex`).
    *
    * rmutex provides a convenient way to encapsulate a data member with an associated
-   * `std::mutex`, ensuring that access to this data is synchronized across multiple threads.
+   * mutex, ensuring that access to this data is synchronized across multiple threads.
    * It follows the RAII (Resource Acquisition Is Initialization) principle by using
    * `rmutex_ref` to manage the lock's lifetime.
    *
    * @note This class explicitly prevents instantiation with `const`-qualified types
    * via a `static_assert`, as mutexes are unnecessary and inefficient for immutable data.
    *
+   * The constructors that build `T` are `constexpr`. When `T` can be constant-initialized
+   * from the arguments and `Mutex` satisfies `constant_initializable_lockable`, an rmutex
+   * can be declared `constinit`. It then has no dynamic initializer and can be used from
+   * any other static initializer, whatever the initialization order:
+   *
+   * @code
+   * constinit rmutex<std::vector<handler>> handlers;
+   * @endcode
+   *
    * @warning `rmutex` is a move-only type; its copy constructor and copy assignment
    * operator are deleted to prevent accidental duplication of the protected resource
    * and potential issues with shared mutex ownership.
    */
-  template <typename T>
+  template <typename T, typename Mutex>
+    requires rmutex_backend<Mutex>
   class rmutex {
       // Static assertion to prevent rmutex from being instantiated with a const-qualified type.
       // Mutexes are for mutable data, and using them with const data is inefficient and unnecessary.
@@ -169,10 +320,43 @@ namespace rmutexpp {
                     "If your data is const, no synchronization is needed.");
       static_assert(is_not_mutex<T>, "rmutex cannot contain another rmutex as the underlying type for obvious reasons.");
 
-      std::mutex _internal_mutex;  ///< The underlying mutex protecting _internal_data.
+      /// @brief The object that is actually locked: `Mutex`, or the lock member of `T` for `intrusive_lock`.
+      using lock_type = typename detail::rmutex_lock_type<T, Mutex>::type;
+
+      static constexpr bool is_intrusive = std::is_same_v<Mutex, intrusive_lock>;
+
+      static_assert(rmutex_lockable<lock_type>, "The lock member named by intrusive_lock_traits<T> must be lockable.");
+
+      /// @brief The underlying mutex protecting _internal_data. At least 2-aligned, so that
+      /// rmutex_guard can keep its ownership flag in bit 0 of the rmutex's address. For
+      /// `intrusive_lock` it is an empty tag that takes no space.
+      [[no_unique_address]] alignas(alignof(Mutex) > 1 ? alignof(Mutex) : 2) Mutex _internal_mutex;
 
       T _internal_data;  ///< The actual data protected by the mutex.
 
+      lock_type& lockable() noexcept {
+        if constexpr (is_intrusive) {
+          return _internal_data.*intrusive_lock_traits<T>::member;
+        } else {
+          return _internal_mutex;
+        }
+      }
+
+      const lock_type& lockable() const noexcept {
+        if constexpr (is_intrusive) {
+          return _internal_data.*intrusive_lock_traits<T>::member;
+        } else {
+          return _internal_mutex;
+        }
+      }
+
+      /**
+       * @brief Moves the data of `other` while the lock of `other`, passed in by the delegating
+       * move constructor, is held.
+       */
+      rmutex(rmutex&& other, std::unique_lock<lock_type>) noexcept(std::is_nothrow_move_constructible_v<T>):
+          _internal_data(std::move(other._internal_data)) { }
+
     public:
       /**
        * @brief Constructs an rmutex object, initializing the protected data with provided arguments.
@@ -180,25 +364,56 @@ namespace rmutexpp {
        * @param args Arguments forwarded to the constructor of the internal data (`_internal_data`).
        */
       template <typename... Args>
-      explicit rmutex(Args&&... args): _internal_data(std::forward<Args>(args)...) { }
+        requires std::constructible_from<T, Args...>
+      constexpr explicit rmutex(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>):
+          _internal_data(std::forward<Args>(args)...) { }
+      /**
+       * @brief Constructs the protected data in place from `args`, with no intermediate `T`.
+       *
+       * Unlike the plain forwarding constructor, this also works when the first argument
+       * would otherwise be taken for something else, and states the intent at the call site.
+       *
+       * @code
+       * rmutex<std::vector<int>> filled(std::in_place, 1024, 7);  // 1024 sevens
+       * @endcode
+       *
+       * @param args Arguments forwarded to the constructor of `T`.
+       */
+      template <typename... Args>
+        requires std::constructible_from<T, Args...>
+      constexpr explicit rmutex(std::in_place_t, Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>):
+          _internal_data(std::forward<Args>(args)...) { }
+      /**
+       * @brief Constructs the protected data in place from a tuple of arguments.
+       *
+       * The arguments are unpacked straight into the constructor of `T` (guaranteed copy
+       * elision), so `T` need not be movable. Use `std::forward_as_tuple` to pass references.
+       *
+       * @param args A tuple of the arguments of `T`'s constructor.
+       */
+      template <typename... Args>
+        requires std::constructible_from<T, Args...>
+      constexpr rmutex(std::piecewise_construct_t, std::tuple<Args...> args):
+          _internal_data(std::make_from_tuple<T>(std::move(args))) { }
       /**
        * @brief Constructs an rmutex object, value-initializing the protected data.
        * This calls the default constructor of the internal data type `T`.
        */
-      rmutex(): _internal_data() { }
+      constexpr rmutex() noexcept(std::is_nothrow_default_constructible_v<T>): _internal_data() { }
       /**
        * @brief Move constructor for rmutex.
        *
-       * Moves the protected data from another rmutex object. The mutex of the
-       * `other` object is locked during the move operation to ensure thread safety
-       * and a consistent state.
+       * Move-constructs the protected data from another rmutex object, once. The mutex
+       * of the `other` object is locked during the move operation to ensure thread
+       * safety and a consistent state. `T` need not be default-constructible.
+       *
+       * The move is `noexcept` when `T`'s is, so `std::vector<rmutex<T>>` relocates
+       * its elements by moving them instead of refusing to grow.
        *
        * @param other The rmutex object to move data from.
        */
-      rmutex(rmutex&& other) noexcept {
-        std::lock_guard<std::mutex> lock(other._internal_mutex);
-        _internal_data = std::move(other._internal_data);
-      }
+      rmutex(rmutex&& other) noexcept(std::is_nothrow_move_constructible_v<T>):
+          rmutex(std::move(other), std::unique_lock<lock_type>(other.lockable())) { }
 
       /**
        * @brief Move assignment operator for rmutex.
@@ -210,12 +425,12 @@ namespace rmutexpp {
        * @param other The rmutex object to move data from.
        * @return A reference to this rmutex object.
        */
-      rmutex& operator=(rmutex&& other) noexcept {
+      rmutex& operator=(rmutex&& other) noexcept(std::is_nothrow_move_assignable_v<T>) {
         if (this != &other) {
           // Lock both mutexes in a consistent order to avoid deadlock
-          std::lock(_internal_mutex, other._internal_mutex);
-          std::lock_guard<std::mutex> lock1(_internal_mutex, std::adopt_lock);
-          std::lock_guard<std::mutex> lock2(other._internal_mutex, std::adopt_lock);
+          std::lock(lockable(), other.lockable());
+          std::lock_guard<lock_type> lock1(lockable(), std::adopt_lock);
+          std::lock_guard<lock_type> lock2(other.lockable(), std::adopt_lock);
           _internal_data = std::move(other._internal_data);
         }
         return *this;
@@ -238,8 +453,10 @@ namespace rmutexpp {
         requires all_are_rmutex<Ts...>
       friend class rmutex_guard;
 
-      template <typename U>
+      template <typename U, typename M>
       friend class rmutex_ref;
+
+      friend struct detail::rmutex_access;
       /**
        * @brief Acquires a lock on the rmutex and returns an rmutex_ref for mutable access.
        *
@@ -251,7 +468,7 @@ namespace rmutexpp {
        * a mutable reference to the protected data.
        * @sa rmutex_ref::operator*(), rmutex_ref::operator->(), rmutex_ref::operator T&()
        */
-      [[nodiscard]] rmutex_ref<T> lock() { return rmutex_ref(*this); }
+      [[nodiscard]] rmutex_ref<T, Mutex> lock() { return rmutex_ref(*this); }
 
       /**
        * @brief Acquires a lock on the rmutex and returns an rmutex_ref for const access.
@@ -265,19 +482,165 @@ namespace rmutexpp {
        * a const reference to the protected data.
        * @sa rmutex_ref::operator*() const, rmutex_ref::operator->() const, rmutex_ref::operator const T&() const
        */
-      [[nodiscard]] std::optional<rmutex_ref<T>> try_lock() { return rmutex_ref<T>::try_acquire(*this); }
+      [[nodiscard]] std::optional<rmutex_ref<T, Mutex>> try_lock() { return rmutex_ref<T, Mutex>::try_acquire(*this); }
+
+      /**
+       * @brief Runs `fn` on the protected data between a lock and an unlock.
+       *
+       * Unlike `lock()`, no `rmutex_ref` is materialized: there is no owns flag to test
+       * and nothing to move, so the whole critical section inlines into the caller.
+       * The result of `fn` is forwarded; do not return references into the data.
+       *
+       * @code
+       * std::size_t queued = jobs.with_lock([&](auto& queue) {
+       *   queue.push_back(job);
+       *   return queue.size();
+       * });
+       * @endcode
+       *
+       * @param fn Callable invoked as `fn(T&)` while the lock is held.
+       * @return Whatever `fn` returns.
+       */
+      template <typename Fn>
+        requires std::invocable<Fn, T&>
+      RMUTEX_ALWAYS_INLINE decltype(auto) with_lock(Fn&& fn) {
+        std::lock_guard<lock_type> lock(lockable());
+        return std::invoke(std::forward<Fn>(fn), _internal_data);
+      }
+
+      /**
+       * @brief Publishes a new value and returns the previous one.
+       *
+       * The lock is held only while the two values are swapped. The old value is
+       * returned after the unlock, so the caller destroys it outside the critical section.
+       * This makes "build aside, swap in" cheap:
+       *
+       * @code
+       * std::vector<route> rebuilt = compute_routes();  // No lock held.
+       * auto previous = routes.replace(std::move(rebuilt));
+       * @endcode
+       *
+       * @param value The new value; it receives the old value during the swap.
+       * @return The previous value.
+       */
+      T replace(T&& value)
+        requires std::is_swappable_v<T>
+      {
+        {
+          std::lock_guard<lock_type> lock(lockable());
+          using std::swap;
+          swap(_internal_data, value);
+        }
+        return std::move(value);
+      }
+
+      /**
+       * @brief Takes the value out, leaving a value-initialized `T` behind.
+       *
+       * The replacement `T{}` is constructed before locking; only the swap runs under the lock.
+       *
+       * @return The previous value.
+       */
+      [[nodiscard]] T take()
+        requires std::is_swappable_v<T> && std::is_default_constructible_v<T>
+      {
+        return replace(T {});
+      }
+
+      /**
+       * @brief Makes the data read-only for good, for data built under the lock and then never written.
+       *
+       * Waits for the current holder of the lock, then freezes the backend. From then on
+       * `read()` returns the data without any locking, and the lock must not be taken
+       * again: `lock()` and everything built on it terminate the program, in release
+       * builds too, while `try_lock()` returns an empty optional.
+       *
+       * @code
+       * rmutex<route_table, freezable_mutex<>> routes;
+       * load_routes_in_parallel(routes);  // Writers lock as usual.
+       * routes.freeze();
+       * const route_table& table = routes.read();  // No lock, from any thread.
+       * @endcode
+       */
+      void freeze()
+        requires freezable_lockable<lock_type>
+      {
+        lockable().freeze();
+      }
+
+      /// @brief Whether `freeze()` was called. Seeing true makes `read()` safe on the calling thread.
+      [[nodiscard]] bool frozen() const noexcept
+        requires freezable_lockable<lock_type>
+      {
+        return lockable().frozen();
+      }
+
+      /**
+       * @brief Returns the frozen data, without locking.
+       * @pre `freeze()` happened before this call: the calling thread froze the rmutex, saw
+       * `frozen()` return true, or was started after the freeze.
+       */
+      [[nodiscard]] const T& read() const noexcept
+        requires freezable_lockable<lock_type>
+      {
+        RMUTEX_ASSERT(lockable().frozen(), "read() before freeze()");
+        return _internal_data;
+      }
+
+      /**
+       * @brief Exchanges the protected value with `other` under the lock.
+       * @param other The value to exchange with; it is not protected by any lock.
+       */
+      void swap(T& other)
+        requires std::is_swappable_v<T>
+      {
+        std::lock_guard<lock_type> lock(lockable());
+        using std::swap;
+        swap(_internal_data, other);
+      }
   };
+  /**
+   * @brief An rmutex whose lock is a data member of `T`, typically placed in padding that `T`
+   * already has, so locking adds no bytes at all: `sizeof(intrusive_rmutex<T>) == sizeof(T)`.
+   *
+   * The member is `T::rmutex_lock` unless `intrusive_lock_traits<T>` names another one, and
+   * it can be any `rmutex_lockable` type: `word_mutex` fits in 4 bytes of padding,
+   * `spin_mutex` in 1. `rmutex_ref`, `rmutex_guard` and every other rmutex operation work
+   * unchanged. `T`'s copy and move operations must leave the lock member alone.
+   *
+   * Give `T` a constructor for its data members. Without one, `std::in_place` arguments
+   * aggregate-initialize `T` and leave the lock member out, which warns under
+   * `-Wmissing-field-initializers`.
+   *
+   * @code
+   * struct order {
+   *   std::uint64_t id;
+   *   std::uint32_t quantity;
+   *   rmutexpp::word_mutex rmutex_lock;  // Lives in what was padding.
+   *
+   *   order(std::uint64_t i, std::uint32_t q) noexcept: id(i), quantity(q) { }
+   * };
+   * intrusive_rmutex<order> pending(std::in_place, 7u, 3u);
+   * @endcode
+   */
+  template <typename T>
+  using intrusive_rmutex = rmutex<T, intrusive_lock>;
+
   /**
    * @class rmutex_ref
    * @brief A RAII-style reference to data protected by an rmutex, providing scoped lock management.
    * @tparam T The type of the data being protected by the rmutex.
    * This cannot be a const-qualified type (e.g., `const int`) because rmutex is enforced to be non-const. Reference constness depends on
    * the user.
+   * @tparam Mutex The lock backend of the rmutex the reference was obtained from.
    *
    * rmutex_ref acts as a smart pointer/reference that, upon construction, acquires a lock on
    * the associated `rmutex` and provides access to its protected data. The lock is
-   * automatically released when the `rmutex_ref` object goes out of scope (due to its
-   * internal `std::unique_lock`'s destructor).
+   * automatically released when the `rmutex_ref` object goes out of scope.
+   *
+   * The reference stores nothing but a pointer to the rmutex: the data and the lock are
+   * derived from it, and a null pointer means the lock is not held. It is therefore
+   * pointer-sized, passed in a register and moved by copying one word.
    *
    * This class ensures thread-safe access to data managed by an `rmutex` by strictly
    * enforcing that the mutex remains locked for the duration of the `rmutex_ref`'s lifetime.
@@ -291,29 +654,38 @@ namespace rmutexpp {
    * For explicit lock attempts that might fail, use `rmutex::try_lock()` which
    * returns an `std::optional<rmutex_ref>`.
    */
-  template <typename T>
+  template <typename T, typename Mutex>
   class rmutex_ref {
-      T& data;
+      /// @brief The locked rmutex, or `nullptr` once the lock has been released or moved away.
+      rmutex<T, Mutex>* _mutex;
 
-      std::unique_lock<std::mutex> _internal_lock;
       /**
        * @brief Private constructor for rmutex_ref, used internally to adopt an already acquired lock.
        *
        * This constructor is typically called by static factory methods like `try_acquire`
-       * when a lock has been successfully obtained. It takes ownership of an existing
-       * `std::unique_lock` and associates it with the protected data reference.
+       * when a lock has been successfully obtained.
        *
-       * @param mutex_data_ref A reference to the data protected by the mutex.
-       * @param lock An rvalue-reference to an `std::unique_lock` that has already
-       * successfully acquired the mutex. Ownership of this lock is moved
-       * into the `rmutex_ref` object.
+       * @param mutex The rmutex whose lock the caller already holds.
        */
-      rmutex_ref(T& mutex_data_ref, std::unique_lock<std::mutex>&& lock): data(mutex_data_ref), _internal_lock(std::move(lock)) {
+      rmutex_ref(rmutex<T, Mutex>& mutex, std::adopt_lock_t) noexcept: _mutex(&mutex) {
 #ifdef DEBUG_RMUTEX
-        std::cout << "rmutex_ref constructed (adopted lock). Type of data: " << typeid(data).name() << std::endl;
+        std::cout << "rmutex_ref constructed (adopted lock). Type of data: " << typeid(T).name() << std::endl;
 #endif
       }
 
+      /**
+       * @brief Unlocks the rmutex if this reference holds it, then destroys the objects
+       * deferred through it. Safe to call twice.
+       */
+      void release() noexcept {
+        if (rmutex<T, Mutex>* mutex = std::exchange(_mutex, nullptr)) {
+          mutex->lockable().unlock();
+          if (detail::deferred_pending() && !detail::still_held_by_caller(mutex->lockable())) {
+            detail::flush_deferred(&mutex->_internal_data);
+          }
+        }
+      }
+
     public:
       /**
        * @brief Constructs an rmutex_ref, acquiring a lock on the rmutex.
@@ -325,12 +697,10 @@ namespace rmutexpp {
        * @tparam T The type of data in the rmutex.
        * @param mutex An l-value reference to the rmutex to lock.
        */
-      explicit rmutex_ref(rmutex<T>& mutex):
-          data(mutex._internal_data),            // Access private data (requires friend declaration)
-          _internal_lock(mutex._internal_mutex)  // Acquire lock on private mutex
-      {
+      explicit rmutex_ref(rmutex<T, Mutex>& mutex): _mutex(&mutex) {
+        mutex.lockable().lock();
 #ifdef DEBUG_RMUTEX
-        std::cout << "rmutex_ref constructed (locked). Type of data: " << typeid(data).name() << std::endl;
+        std::cout << "rmutex_ref constructed (locked). Type of data: " << typeid(T).name() << std::endl;
 #endif
       }
       /**
@@ -345,17 +715,16 @@ namespace rmutexpp {
        * @return An std::optional<rmutex_ref<T>> containing the rmutex_ref if locked,
        * or std::nullopt if the lock could not be acquired.
        */
-      static std::optional<rmutex_ref<T>> try_acquire(rmutex<T>& mutex) {
+      static std::optional<rmutex_ref<T, Mutex>> try_acquire(rmutex<T, Mutex>& mutex) {
 #ifdef DEBUG_RMUTEX
         std::cout << "Attempting to acquire lock via try_acquire..." << std::endl;
 #endif
-        std::unique_lock<std::mutex> lock(mutex._internal_mutex, std::try_to_lock);
-        if (lock.owns_lock()) {
+        if (mutex.lockable().try_lock()) {
 #ifdef DEBUG_RMUTEX
           std::cout << "  Lock successfully acquired." << std::endl;
 #endif
           // Use the private constructor to create an rmutex_ref with the adopted lock
-          return rmutex_ref<T>(mutex._internal_data, std::move(lock));
+          return rmutex_ref<T, Mutex>(mutex, std::adopt_lock);
         } else {
 #ifdef DEBUG_RMUTEX
           std::cout << "  Failed to acquire lock." << std::endl;
@@ -364,24 +733,23 @@ namespace rmutexpp {
         }
       }
       /**
-       * @brief Default destructor for rmutex_ref.
+       * @brief Destructor for rmutex_ref.
        *
-       * When an rmutex_ref object is destroyed, its owned lock (std::unique_lock)
-       * is also destroyed. This automatically releases the underlying mutex,
-       * making the protected data available for other threads.
+       * When an rmutex_ref object is destroyed, its lock is released, making the
+       * protected data available for other threads. Objects passed to
+       * `defer_after_unlock()` or `retire()` are destroyed (or handed to their
+       * reclaimer) right after the release.
        */
-      ~rmutex_ref() = default;
+      ~rmutex_ref() { release(); }
       /**
        * @brief Move constructor for rmutex_ref.
        *
        * Transfers ownership of the mutex lock from `other` to the newly constructed object.
-       * After the move, `other` will no longer own the lock, and the new object
-       * will manage the lock and provide access to the same underlying data.
+       * After the move, `other` no longer owns the lock and must not be dereferenced.
        *
        * @param other The rmutex_ref object to move from.
        */
-      rmutex_ref(rmutex_ref<T>&& other) noexcept: _internal_lock(std::move(other._internal_lock)), data(other.data) {
-        // Assuming it is locked because cannot unlock via function calls
+      rmutex_ref(rmutex_ref<T, Mutex>&& other) noexcept: _mutex(std::exchange(other._mutex, nullptr)) {
 #ifdef DEBUG_RMUTEX
         std::cout << "Move constructor" << std::endl;
 #endif
@@ -398,28 +766,26 @@ namespace rmutexpp {
        * @param other The rmutex_ref object to move from.
        * @return A reference to this rmutex_ref object.
        */
-      rmutex_ref<T>& operator=(rmutex_ref<T>&& other) noexcept {
+      rmutex_ref<T, Mutex>& operator=(rmutex_ref<T, Mutex>&& other) noexcept {
         if (this != &other) {
-          // std::unique_lock's move assignment handles releasing the current lock
-          // and acquiring ownership from 'other'.
-          _internal_lock = std::move(other._internal_lock);
-          data           = other.data;  // 'data' is a reference, so it refers to the same object
+          release();
+          _mutex = std::exchange(other._mutex, nullptr);
         }
         return *this;
       }
       // Copy constructor and assignment are deleted to prevent deadlocks or accidental releases
-      rmutex_ref(const rmutex_ref<T>&)               = delete;
-      rmutex_ref<T>& operator=(const rmutex_ref<T>&) = delete;
+      rmutex_ref(const rmutex_ref<T, Mutex>&)                      = delete;
+      rmutex_ref<T, Mutex>& operator=(const rmutex_ref<T, Mutex>&) = delete;
       /**
        * @brief Dereference operator to access the protected data.
        * @return A reference to the protected data.
        */
-      T& operator*() { return data; }
+      T& operator*() { return _mutex->_internal_data; }
       /**
        * @brief Member access operator to access members of the protected data.
        * @return A pointer to the protected data.
        */
-      T* operator->() { return &data; }
+      T* operator->() { return &_mutex->_internal_data; }
       /**
        * @brief Implicit conversion operator to T&.
        *
@@ -429,17 +795,17 @@ namespace rmutexpp {
        *
        * @return A reference to the protected data.
        */
-      operator T&() { return data; }
+      operator T&() { return _mutex->_internal_data; }
       /**
        * @brief Dereference operator to access the protected data.
        * @return A reference to the protected data.
        */
-      const T& operator*() const { return data; }
+      const T& operator*() const { return _mutex->_internal_data; }
       /**
        * @brief Member access operator to access members of the protected data.
        * @return A pointer to the protected data.
        */
-      const T* operator->() const { return &data; }
+      const T* operator->() const { return &_mutex->_internal_data; }
       /**
        * @brief Implicit conversion operator to T&.
        *
@@ -449,7 +815,7 @@ namespace rmutexpp {
        *
        * @return A reference to the protected data.
        */
-      operator const T&() const { return data; }
+      operator const T&() const { return _mutex->_internal_data; }
       /**
        * @brief Dereference operator to access elements using array-like indexing (non-const).
        *
@@ -461,38 +827,105 @@ namespace rmutexpp {
        * @warning This operator is only available if the underlying `T` supports `operator[]`.
        * The behavior for out-of-bounds access depends on the `T` type's `operator[]` implementation.
        */
-      decltype(auto) operator[](std::size_t index) { return data[index]; }
+      decltype(auto) operator[](std::size_t index) { return _mutex->_internal_data[index]; }
       /**
        * @brief Conversion operator to bool.
        * @return True if the rmutex_ref currently owns its lock, false otherwise.
        */
-      explicit operator bool() const& noexcept { return _internal_lock.owns_lock(); }
+      explicit operator bool() const& noexcept { return _mutex != nullptr; }
+      /**
+       * @brief Non-const overload of the conversion to bool.
+       *
+       * Without it, converting a non-const `rmutex_ref<int>` to bool would prefer
+       * `operator T&()` and test the protected value instead of the ownership.
+       * @return True if the rmutex_ref currently owns its lock, false otherwise.
+       */
+      explicit operator bool() & noexcept { return _mutex != nullptr; }
+      /**
+       * @brief Takes ownership of an object removed from the protected data and destroys it
+       * right after this reference releases the lock.
+       *
+       * Use it for values erased or replaced inside the critical section, so that their
+       * destructors and deallocations do not run while other threads wait.
+       *
+       * @code
+       * auto node = ref->extract(key);         // std::map node handle
+       * ref.defer_after_unlock(std::move(node));
+       * @endcode
+       *
+       * On a reference that holds no lock the object is destroyed right away. With a
+       * recursive backend, objects deferred through a nested reference wait for the
+       * outermost release. Release the reference on the thread that deferred through it:
+       * the objects are queued on that thread (see deferred_destruction.hpp).
+       *
+       * @param doomed The object to destroy; must be an rvalue.
+       */
+      template <typename U>
+        requires(!std::is_lvalue_reference_v<U>)
+      void defer_after_unlock(U&& doomed) & {
+        if (_mutex) {
+          detail::defer_destruction(&_mutex->_internal_data, nullptr, std::move(doomed));
+        } else {
+          detail::destroy_undeferred(nullptr, std::move(doomed));
+        }
+      }
+      /**
+       * @brief Like `defer_after_unlock()`, but the object is destroyed on `reclaimer`'s thread.
+       * @param doomed The object to destroy; must be an rvalue.
+       * @param reclaimer The reclaimer the object is handed to after the lock is released,
+       * or right away if this reference holds no lock.
+       */
+      template <typename U>
+        requires(!std::is_lvalue_reference_v<U>)
+      void retire(U&& doomed, background_reclaimer& reclaimer) & {
+        if (_mutex) {
+          detail::defer_destruction(&_mutex->_internal_data, &reclaimer, std::move(doomed));
+        } else {
+          detail::destroy_undeferred(&reclaimer, std::move(doomed));
+        }
+      }
   };
 
+  namespace detail {
+    struct rmutex_access {
+        template <typename T, typename Mutex>
+        static auto& mutex(rmutex<T, Mutex>& m) noexcept {
+          return m.lockable();
+        }
+
+        template <typename T, typename Mutex>
+        static T& data(rmutex<T, Mutex>& m) noexcept {
+          return m._internal_data;
+        }
+    };
+  }  // namespace detail
+
   // Deduction guides - allows the compiler to deduce template arguments from constructor arguments.
   // Crucially, these now take an l-value reference to rmutex<T> to enforce l-value binding.
 
   /**
    * @brief Deduction guide for rmutex_ref when constructed with a regular lock.
    * @tparam T The type of data in the rmutex.
+   * @tparam Mutex The lock backend of the rmutex.
    * @param arg An l-value reference to the rmutex object.
-   * @return rmutex_ref<T>
+   * @return rmutex_ref<T, Mutex>
    */
-  template <typename T>
-  rmutex_ref(rmutex<T>& arg) -> rmutex_ref<T>;
+  template <typename T, typename Mutex>
+  rmutex_ref(rmutex<T, Mutex>& arg) -> rmutex_ref<T, Mutex>;
 
   /**
    * @brief Deduction guide for rmutex_ref when constructed with std::try_to_lock.
    * @tparam T The type of data in the rmutex.
+   * @tparam Mutex The lock backend of the rmutex.
    * @param tag `std::try_to_lock_t`
    * @param arg An l-value reference to the rmutex object.
-   * @return rmutex_ref<T>
+   * @return rmutex_ref<T, Mutex>
    */
-  template <typename T>
-  rmutex_ref(std::try_to_lock_t, rmutex<T>& arg) -> rmutex_ref<T>;
-  template <typename T>
-  [[deprecated("Scope the rmutex_ref instead of using unlock()")]] void unlock(rmutex_ref<T>& reference) {
-    reference.~rmutex_ref();
+  template <typename T, typename Mutex>
+  rmutex_ref(std::try_to_lock_t, rmutex<T, Mutex>& arg) -> rmutex_ref<T, Mutex>;
+  template <typename T, typename Mutex>
+  [[deprecated("Scope the rmutex_ref instead of using unlock()")]] void unlock(rmutex_ref<T, Mutex>& reference) {
+    rmutex_ref<T, Mutex> released(std::move(reference));  // Unlocks at the end of this scope.
   }
 }  // namespace rmutexpp
 #endif
\ No newline at end of file
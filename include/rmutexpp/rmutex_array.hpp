@@ -0,0 +1,240 @@
+/**
+ * @file rmutex_array.hpp
+ * @brief Defines rmutex_array, a fixed-size array of independently locked elements
+ * whose locks and payloads are stored in two separate arrays.
+ *
+ * A `std::vector<rmutex<Big>>` interleaves every lock with its payload: a scan that
+ * only checks or takes the locks drags every payload's cache lines along, and a pass
+ * over the payloads strides over 40-byte `std::mutex`es. `rmutex_array<T>` lays the
+ * same elements out as a structure of arrays:
+ *
+ * - the lock words, contiguous (`word_mutex` by default: 16 per cache line), or one per
+ *   cache line with `lock_layout::padded` when neighboring elements are hot on
+ *   different threads;
+ * - the payloads, contiguous in one `std::vector<T>`.
+ *
+ * `lock(i)` pairs lock `i` with payload `i`. `lock_all()` takes every lock in index
+ * order and hands out the payloads as one `std::span`.
+ *
+ * @note The array is never resized: its size is fixed at construction.
+ */
+#ifndef _RMUTEX_ARRAY_HEADER_
+#define _RMUTEX_ARRAY_HEADER_
+
+#include <cstddef>     // For std::size_t
+#include <functional>  // For std::invoke
+#include <memory>      // For std::unique_ptr
+#include <mutex>       // For std::lock_guard
+#include <optional>    // For std::optional
+#include <span>        // For std::span
+#include <utility>     // For std::exchange, std::forward
+#include <vector>      // For std::vector
+
+#include "rmutex.hpp"           // For rmutex_lockable, RMUTEX_ALWAYS_INLINE
+#include "rmutex_backends.hpp"  // For word_mutex
+
+namespace rmutexpp {
+
+  /**
+   * @enum lock_layout
+   * @brief How the lock array of an `rmutex_array` is laid out.
+   */
+  enum class lock_layout {
+    dense,  ///< Locks back to back: the fastest scans, but neighbors share cache lines.
+    padded  ///< One lock per cache line: no false sharing between neighbors, at 64 bytes per lock.
+  };
+
+  namespace detail {
+    template <typename Mutex, lock_layout Layout>
+    struct lock_slot {
+        Mutex lock;
+    };
+
+    template <typename Mutex>
+    struct alignas(64) lock_slot<Mutex, lock_layout::padded> {
+        Mutex lock;
+    };
+  }  // namespace detail
+
+  template <typename T, typename Mutex, lock_layout Layout>
+    requires rmutex_lockable<Mutex>
+  class rmutex_array;
+
+  /**
+   * @class rmutex_array_ref
+   * @brief Scoped access to one locked element of an `rmutex_array`; the lock is released on destruction.
+   * @tparam T The element type.
+   * @tparam Mutex The lock backend of the array.
+   */
+  template <typename T, typename Mutex>
+  class rmutex_array_ref {
+      Mutex* _lock;  ///< Null once moved from.
+      T*     _data;
+
+      rmutex_array_ref(Mutex& lock, T& data) noexcept: _lock(&lock), _data(&data) { }
+
+      template <typename U, typename M, lock_layout Layout>
+        requires rmutex_lockable<M>
+      friend class rmutex_array;
+
+    public:
+      rmutex_array_ref(rmutex_array_ref&& other) noexcept: _lock(std::exchange(other._lock, nullptr)), _data(other._data) { }
+
+      rmutex_array_ref& operator=(rmutex_array_ref&& other) noexcept {
+        if (this != &other) {
+          if (_lock) {
+            _lock->unlock();
+          }
+          _lock = std::exchange(other._lock, nullptr);
+          _data = other._data;
+        }
+        return *this;
+      }
+
+      rmutex_array_ref(const rmutex_array_ref&)            = delete;
+      rmutex_array_ref& operator=(const rmutex_array_ref&) = delete;
+
+      ~rmutex_array_ref() {
+        if (_lock) {
+          _lock->unlock();
+        }
+      }
+
+      /// @brief Whether this ref holds the element's lock (false once moved from).
+      bool owns() const noexcept { return _lock != nullptr; }
+
+      T& operator*() const noexcept { return *_data; }
+
+      T* operator->() const noexcept { return _data; }
+  };
+
+  /**
+   * @class rmutex_array
+   * @brief A fixed-size array of elements, each protected by its own lock, stored as
+   * a lock array plus a payload array.
+   * @tparam T The element type.
+   * @tparam Mutex The lock backend of every element, `word_mutex` by default: a 40-byte
+   * `std::mutex` per element would defeat the dense lock array.
+   * @tparam Layout Whether the lock array is dense or padded to one lock per cache line.
+   *
+   * @code
+   * rmutex_array<session> sessions(4096);
+   * sessions.lock(id)->touch();
+   * std::size_t visited = sessions.try_for_each([](std::size_t, session& s) { s.expire_if_idle(); });
+   * @endcode
+   */
+  template <typename T, typename Mutex = word_mutex, lock_layout Layout = lock_layout::dense>
+    requires rmutex_lockable<Mutex>
+  class rmutex_array {
+      using slot_type = detail::lock_slot<Mutex, Layout>;
+
+      std::unique_ptr<slot_type[]> _locks;
+      std::vector<T>               _data;
+
+    public:
+      /// @brief `count` value-initialized elements.
+      explicit rmutex_array(std::size_t count): _locks(new slot_type[count]), _data(count) { }
+
+      /// @brief `count` copies of `value`.
+      rmutex_array(std::size_t count, const T& value): _locks(new slot_type[count]), _data(count, value) { }
+
+      rmutex_array(const rmutex_array&)            = delete;
+      rmutex_array& operator=(const rmutex_array&) = delete;
+
+      std::size_t size() const noexcept { return _data.size(); }
+
+      /// @brief Locks element `index` and returns the scoped access to it. @pre `index < size()`.
+      [[nodiscard]] rmutex_array_ref<T, Mutex> lock(std::size_t index) {
+        _locks[index].lock.lock();
+        return { _locks[index].lock, _data[index] };
+      }
+
+      /// @brief Attempts to lock element `index` without blocking. @pre `index < size()`.
+      [[nodiscard]] std::optional<rmutex_array_ref<T, Mutex>> try_lock(std::size_t index) {
+        if (!_locks[index].lock.try_lock()) {
+          return std::nullopt;
+        }
+        return rmutex_array_ref<T, Mutex>(_locks[index].lock, _data[index]);
+      }
+
+      /**
+       * @brief Runs `fn` on element `index` between a lock and an unlock, see `rmutex::with_lock()`.
+       * @pre `index < size()`.
+       */
+      template <typename Fn>
+        requires std::invocable<Fn, T&>
+      RMUTEX_ALWAYS_INLINE decltype(auto) with_lock(std::size_t index, Fn&& fn) {
+        std::lock_guard<Mutex> lock(_locks[index].lock);
+        return std::invoke(std::forward<Fn>(fn), _data[index]);
+      }
+
+      /**
+       * @brief Visits every element whose lock can be taken without waiting, skipping the others.
+       *
+       * Only the lock array is touched for the skipped elements, which is where the
+       * separate arrays pay off: finding the few free (or the few busy) elements of a
+       * large array reads 4 bytes per element instead of a lock and a payload.
+       *
+       * @param fn Called as `fn(index, T&)` under the element's lock.
+       * @return The number of elements visited.
+       */
+      template <typename Fn>
+        requires std::invocable<Fn, std::size_t, T&>
+      std::size_t try_for_each(Fn&& fn) {
+        std::size_t visited = 0;
+        for (std::size_t index = 0; index < _data.size(); ++index) {
+          if (_locks[index].lock.try_lock()) {
+            std::lock_guard<Mutex> lock(_locks[index].lock, std::adopt_lock);
+            std::invoke(fn, index, _data[index]);
+            ++visited;
+          }
+        }
+        return visited;
+      }
+
+      /**
+       * @class all_ref
+       * @brief Every element locked at once; the payloads are reachable as one contiguous span.
+       */
+      class all_ref {
+          rmutex_array* _array;  ///< Null once moved from.
+
+          explicit all_ref(rmutex_array& array) noexcept: _array(&array) { }
+
+          friend class rmutex_array;
+
+        public:
+          all_ref(all_ref&& other) noexcept: _array(std::exchange(other._array, nullptr)) { }
+
+          all_ref& operator=(all_ref&&)      = delete;
+          all_ref(const all_ref&)            = delete;
+          all_ref& operator=(const all_ref&) = delete;
+
+          ~all_ref() {
+            if (_array) {
+              for (std::size_t index = _array->size(); index-- > 0;) {
+                _array->_locks[index].lock.unlock();
+              }
+            }
+          }
+
+          std::span<T> operator*() const noexcept { return _array->_data; }
+
+          std::span<T> span() const noexcept { return _array->_data; }
+      };
+
+      /**
+       * @brief Locks every element, in index order, for a pass over the contiguous payloads.
+       *
+       * Locking in index order makes two `lock_all()` calls safe against each other. Do not
+       * call it while holding one of the array's element refs.
+       */
+      [[nodiscard]] all_ref lock_all() {
+        for (std::size_t index = 0; index < _data.size(); ++index) {
+          _locks[index].lock.lock();
+        }
+        return all_ref(*this);
+      }
+  };
+}  // namespace rmutexpp
+#endif  // _RMUTEX_ARRAY_HEADER_
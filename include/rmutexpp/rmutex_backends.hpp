@@ -0,0 +1,372 @@
+/**
+ * @file rmutex_backends.hpp
+ * @brief Alternative lock backends for rmutex, selected through its `Mutex` template parameter.
+ *
+ * `rmutex<T>` defaults to `std::mutex`, which is portable but large (40 bytes with
+ * glibc) and always takes the generic pthread path. The backends in this header
+ * model the same *Lockable* interface (`lock()`, `try_lock()`, `unlock()`) and can be
+ * plugged in as `rmutex<T, spin_mutex>` or `rmutex<T, word_mutex>`:
+ *
+ * - `spin_mutex`: one byte, test-and-test-and-set with exponential backoff. It never
+ *   sleeps, so it is only appropriate for very short critical sections on threads
+ *   that are not oversubscribed.
+ * - `word_mutex`: four bytes, spins briefly and then parks the waiter on the lock word
+ *   through C++20 `std::atomic::wait` (a futex on Linux). Unlock only issues a wake-up
+ *   when a waiter announced itself.
+ *
+ * Both backends honor the single-threaded mode of `single_threaded.hpp`: while it is
+ * on, they lock and unlock with plain loads and stores.
+ *
+ * `recursive_word_mutex` is the reentrant counterpart of `word_mutex`: the lock word
+ * holds the owner's thread tag, so a re-lock by the owner is a relaxed load and an
+ * increment.
+ *
+ * `freezable_mutex<Base>` wraps any of them for data that is built under the lock
+ * and then never written again: after `rmutex::freeze()`, `rmutex::read()` returns the
+ * data without locking.
+ */
+#ifndef _RMUTEX_BACKENDS_HEADER_
+#define _RMUTEX_BACKENDS_HEADER_
+
+#include <atomic>     // For std::atomic, std::memory_order
+#include <cstdint>    // For std::uint32_t, std::uintptr_t
+#include <exception>  // For std::terminate
+
+#include "single_threaded.hpp"  // For single_threaded, RMUTEX_ASSERT
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>  // For _mm_pause
+#endif
+
+namespace rmutexpp {
+
+  /**
+   * @brief Tells the CPU that the calling thread is busy-waiting.
+   *
+   * Emits `pause` on x86 and `yield` on ARM, which reduces the power and memory-order
+   * speculation penalty of spin loops and lets a sibling hyper-thread make progress.
+   */
+  inline void cpu_relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+  }
+
+  /**
+   * @class spin_mutex
+   * @brief A one-byte test-and-test-and-set spin lock with exponential backoff.
+   *
+   * Waiters spin on a relaxed load (keeping the cache line shared) and only retry the
+   * exchange once the lock looks free. The backoff doubles up to 64 `cpu_relax()`
+   * iterations between attempts.
+   *
+   * @warning spin_mutex never blocks in the kernel. When a lock holder is preempted,
+   * every waiter burns its whole time slice; prefer `word_mutex` when threads may
+   * outnumber cores.
+   */
+  class spin_mutex {
+      std::atomic<bool> _locked { false };
+
+    public:
+      constexpr spin_mutex() noexcept = default;
+
+      spin_mutex(const spin_mutex&)            = delete;
+      spin_mutex& operator=(const spin_mutex&) = delete;
+
+      /// @brief Acquires the lock, spinning until it becomes available.
+      void lock() noexcept {
+        if (single_threaded()) {
+          RMUTEX_ASSERT(detail::single_threaded_caller(), "spin_mutex locked by a second thread in single-threaded mode");
+          RMUTEX_ASSERT(!_locked.load(std::memory_order_relaxed), "spin_mutex locked twice in single-threaded mode");
+          _locked.store(true, std::memory_order_relaxed);
+          return;
+        }
+        unsigned backoff = 1;
+        while (_locked.exchange(true, std::memory_order_acquire)) {
+          do {
+            for (unsigned i = 0; i < backoff; ++i) {
+              cpu_relax();
+            }
+            backoff = backoff < 64 ? backoff * 2 : backoff;
+          } while (_locked.load(std::memory_order_relaxed));
+        }
+      }
+
+      /**
+       * @brief Attempts to acquire the lock without spinning.
+       * @return True if the lock was acquired.
+       */
+      bool try_lock() noexcept {
+        if (single_threaded()) {
+          RMUTEX_ASSERT(detail::single_threaded_caller(), "spin_mutex locked by a second thread in single-threaded mode");
+          if (_locked.load(std::memory_order_relaxed)) {
+            return false;
+          }
+          _locked.store(true, std::memory_order_relaxed);
+          return true;
+        }
+        return !_locked.load(std::memory_order_relaxed) && !_locked.exchange(true, std::memory_order_acquire);
+      }
+
+      /// @brief Releases the lock.
+      void unlock() noexcept { _locked.store(false, single_threaded() ? std::memory_order_relaxed : std::memory_order_release); }
+  };
+
+  /**
+   * @class word_mutex
+   * @brief A four-byte mutex that spins briefly and then parks on its lock word.
+   *
+   * The lock word follows the classic three-state futex protocol: `0` unlocked, `1`
+   * locked, `2` locked with (possible) waiters. The uncontended paths are a single
+   * compare-exchange to lock and a single exchange to unlock; `notify_one` is only
+   * called when the word was `2`.
+   */
+  class word_mutex {
+      static constexpr std::uint32_t unlocked   = 0;
+      static constexpr std::uint32_t locked     = 1;
+      static constexpr std::uint32_t contended  = 2;
+      static constexpr unsigned      spin_limit = 100;
+
+      std::atomic<std::uint32_t> _state { unlocked };
+
+      void lock_slow() noexcept {
+        for (unsigned spins = 0; spins < spin_limit; ++spins) {
+          std::uint32_t expected = unlocked;
+          if (_state.load(std::memory_order_relaxed) == unlocked &&
+              _state.compare_exchange_weak(expected, locked, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return;
+          }
+          cpu_relax();
+        }
+        // Announce ourselves as a waiter; whoever unlocks a contended word wakes one of us.
+        while (_state.exchange(contended, std::memory_order_acquire) != unlocked) {
+          _state.wait(contended, std::memory_order_relaxed);
+        }
+      }
+
+    public:
+      constexpr word_mutex() noexcept = default;
+
+      word_mutex(const word_mutex&)            = delete;
+      word_mutex& operator=(const word_mutex&) = delete;
+
+      /// @brief Acquires the lock, parking the calling thread if it stays contended.
+      void lock() noexcept {
+        if (single_threaded()) {
+          RMUTEX_ASSERT(detail::single_threaded_caller(), "word_mutex locked by a second thread in single-threaded mode");
+          RMUTEX_ASSERT(_state.load(std::memory_order_relaxed) == unlocked, "word_mutex locked twice in single-threaded mode");
+          _state.store(locked, std::memory_order_relaxed);
+          return;
+        }
+        std::uint32_t expected = unlocked;
+        if (!_state.compare_exchange_strong(expected, locked, std::memory_order_acquire, std::memory_order_relaxed)) {
+          lock_slow();
+        }
+      }
+
+      /**
+       * @brief Attempts to acquire the lock without blocking.
+       * @return True if the lock was acquired.
+       */
+      bool try_lock() noexcept {
+        if (single_threaded()) {
+          RMUTEX_ASSERT(detail::single_threaded_caller(), "word_mutex locked by a second thread in single-threaded mode");
+          if (_state.load(std::memory_order_relaxed) != unlocked) {
+            return false;
+          }
+          _state.store(locked, std::memory_order_relaxed);
+          return true;
+        }
+        std::uint32_t expected = unlocked;
+        return _state.compare_exchange_strong(expected, locked, std::memory_order_acquire, std::memory_order_relaxed);
+      }
+
+      /// @brief Releases the lock and wakes one parked waiter, if any.
+      void unlock() noexcept {
+        if (single_threaded()) {
+          _state.store(unlocked, std::memory_order_relaxed);  // No waiter can exist.
+          return;
+        }
+        if (_state.exchange(unlocked, std::memory_order_release) == contended) {
+          _state.notify_one();
+        }
+      }
+  };
+  namespace detail {
+    // Its address identifies the calling thread. Being an int, it leaves bit 0 of the address free.
+    inline thread_local int thread_tag_anchor = 0;
+
+    inline std::uintptr_t thread_tag() noexcept { return reinterpret_cast<std::uintptr_t>(&thread_tag_anchor); }
+  }  // namespace detail
+
+  /**
+   * @class recursive_word_mutex
+   * @brief A reentrant lock whose word stores the owning thread, for code that re-enters its own critical sections.
+   *
+   * The word holds the owner's thread tag (0 when free) with bit 0 set once a waiter
+   * parked on it, plus a depth counter that only the owner touches. A thread that
+   * already owns the lock finds its own tag with a relaxed load and just increments
+   * the depth. Any other thread takes the `word_mutex` path: a few compare-exchanges,
+   * then parking on the word through `std::atomic::wait`.
+   *
+   * Nested `rmutex_ref`s on the same thread, and an `rmutex_guard` over a mutex the
+   * thread already holds, both work: each acquisition adds one level, each release
+   * removes one. Each nested ref hands out the same `T&`.
+   */
+  class recursive_word_mutex {
+      static constexpr std::uintptr_t unowned    = 0;
+      static constexpr std::uintptr_t contended  = 1;
+      static constexpr unsigned       spin_limit = 100;
+
+      std::atomic<std::uintptr_t> _owner { unowned };
+      std::uint32_t               _depth = 0;
+
+      // The owner's own stores are the only ones that can make the word hold its tag.
+      bool owned_by(std::uintptr_t self) const noexcept { return (_owner.load(std::memory_order_relaxed) & ~contended) == self; }
+
+      void lock_slow(std::uintptr_t self) noexcept {
+        for (unsigned spins = 0; spins < spin_limit; ++spins) {
+          std::uintptr_t expected = unowned;
+          if (_owner.load(std::memory_order_relaxed) == unowned &&
+              _owner.compare_exchange_weak(expected, self, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return;
+          }
+          cpu_relax();
+        }
+        std::uintptr_t current = _owner.load(std::memory_order_relaxed);
+        while (true) {
+          if (current == unowned) {
+            // Having parked, assume others still are: the next unlock wakes one of them.
+            if (_owner.compare_exchange_weak(current, self | contended, std::memory_order_acquire, std::memory_order_relaxed)) {
+              return;
+            }
+            continue;
+          }
+          if (!(current & contended) &&
+              !_owner.compare_exchange_weak(current, current | contended, std::memory_order_relaxed, std::memory_order_relaxed)) {
+            continue;
+          }
+          _owner.wait(current | contended, std::memory_order_relaxed);
+          current = _owner.load(std::memory_order_relaxed);
+        }
+      }
+
+    public:
+      constexpr recursive_word_mutex() noexcept = default;
+
+      recursive_word_mutex(const recursive_word_mutex&)            = delete;
+      recursive_word_mutex& operator=(const recursive_word_mutex&) = delete;
+
+      /// @brief Acquires the lock, or one more level of it if the calling thread already owns it.
+      void lock() noexcept {
+        std::uintptr_t self = detail::thread_tag();
+        if (owned_by(self)) {
+          ++_depth;
+          return;
+        }
+        std::uintptr_t expected = unowned;
+        if (!_owner.compare_exchange_strong(expected, self, std::memory_order_acquire, std::memory_order_relaxed)) {
+          lock_slow(self);
+        }
+        _depth = 1;
+      }
+
+      /**
+       * @brief Attempts to acquire the lock without blocking.
+       * @return True if the lock was acquired or the calling thread already owned it.
+       */
+      bool try_lock() noexcept {
+        std::uintptr_t self = detail::thread_tag();
+        if (owned_by(self)) {
+          ++_depth;
+          return true;
+        }
+        std::uintptr_t expected = unowned;
+        if (_owner.compare_exchange_strong(expected, self, std::memory_order_acquire, std::memory_order_relaxed)) {
+          _depth = 1;
+          return true;
+        }
+        return false;
+      }
+
+      /// @brief Whether the calling thread owns the lock, at any depth.
+      bool held_by_caller() const noexcept { return owned_by(detail::thread_tag()); }
+
+      /// @brief Releases one level; the last one frees the lock and wakes one parked waiter, if any.
+      void unlock() noexcept {
+        if (--_depth != 0) {
+          return;
+        }
+        if (_owner.exchange(unowned, std::memory_order_release) & contended) {
+          _owner.notify_one();
+        }
+      }
+  };
+
+  /**
+   * @class freezable_mutex
+   * @brief A lock backend that can be frozen for good, enabling `rmutex::freeze()` and `rmutex::read()`.
+   * @tparam Base The backend used until the freeze.
+   *
+   * Freezing takes the lock one last time, so every write made under it happens before
+   * the freeze, and publishes the frozen flag with a release store. From then on the
+   * lock must not be taken again: `lock()` calls `std::terminate()`, in every build mode,
+   * since a writer would race with the lock-free readers, and `try_lock()` returns false.
+   * Both check the flag with the base lock held, so they cannot slip in behind a freeze.
+   */
+  template <typename Base = word_mutex>
+  class freezable_mutex {
+      Base              _base;
+      std::atomic<bool> _frozen { false };
+
+    public:
+      constexpr freezable_mutex() noexcept = default;
+
+      freezable_mutex(const freezable_mutex&)            = delete;
+      freezable_mutex& operator=(const freezable_mutex&) = delete;
+
+      /// @brief Acquires the lock of the base backend; terminates if the mutex is frozen.
+      void lock() noexcept(noexcept(_base.lock())) {
+        _base.lock();
+        if (_frozen.load(std::memory_order_relaxed)) {
+          std::terminate();  // A frozen rmutex was locked; use read().
+        }
+      }
+
+      /**
+       * @brief Attempts to acquire the lock without blocking.
+       * @return True if the lock was acquired; always false once frozen.
+       */
+      bool try_lock() noexcept(noexcept(_base.try_lock()) && noexcept(_base.unlock())) {
+        if (!_base.try_lock()) {
+          return false;
+        }
+        if (_frozen.load(std::memory_order_relaxed)) {
+          _base.unlock();
+          return false;
+        }
+        return true;
+      }
+
+      /// @brief Releases the lock of the base backend.
+      void unlock() noexcept(noexcept(_base.unlock())) { _base.unlock(); }
+
+      /**
+       * @brief Freezes the mutex. Waits for the current holder, if any, to unlock first.
+       * @post Any later `lock()` terminates the program.
+       */
+      void freeze() noexcept(noexcept(_base.lock())) {
+        _base.lock();
+        _frozen.store(true, std::memory_order_release);
+        _base.unlock();
+      }
+
+      /// @brief Whether the mutex is frozen. Seeing true synchronizes with `freeze()`.
+      bool frozen() const noexcept { return _frozen.load(std::memory_order_acquire); }
+  };
+}  // namespace rmutexpp
+#endif  // _RMUTEX_BACKENDS_HEADER_
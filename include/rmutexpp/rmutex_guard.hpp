@@ -12,11 +12,15 @@
 #ifndef _RMUTEX_GUARD_HEADER_
 #define _RMUTEX_GUARD_HEADER_
 
-#include <functional>  // For std::cref
-#include <mutex>       // For std::unique_lock, std::lock, std::try_lock, std::defer_lock, std::try_to_lock_t
-#include <optional>    // For std::optional
-#include <tuple>       // For std::tuple, std::make_tuple, std::get, std::tie
-#include <utility>     // For std::move, std::index_sequence, std::index_sequence_for
+#include <algorithm>    // For std::copy
+#include <cstdint>      // For std::uintptr_t
+#include <functional>   // For std::ref, std::cref, std::reference_wrapper, std::invoke
+#include <iterator>     // For std::begin, std::end
+#include <mutex>        // For std::scoped_lock, std::lock, std::try_lock, std::try_to_lock_t
+#include <optional>     // For std::optional
+#include <tuple>        // For std::tuple, std::make_tuple, std::get, std::tie
+#include <type_traits>  // For std::is_lvalue_reference_v
+#include <utility>      // For std::move, std::index_sequence, std::index_sequence_for
 
 #include "rmutex.hpp"  // For rmutex, rmutex_mutex_type_t, rmutex_data_type_t, all_are_rmutex
 
@@ -24,15 +28,24 @@
 #include <iostream>
 #endif
 namespace rmutexpp {
+  namespace detail {
+    /// @brief Bit 0 of the first guarded rmutex's address: set while the guard holds its locks.
+    inline constexpr std::uintptr_t guard_owned_bit = 1;
+  }  // namespace detail
+
   /**
    * @class rmutex_guard
    * @brief A RAII-style lock guard for one or more rmutex objects.
    *
    * This primary template for rmutex_guard manages the acquisition and release of
-   * locks for multiple rmutex instances. It uses `std::unique_lock` internally
-   * and ensures that all specified rmutex objects are locked upon construction
-   * and unlocked upon destruction (or move). It supports both regular locking
-   * and non-blocking `try_lock` semantics.
+   * locks for multiple rmutex instances. It ensures that all specified rmutex objects
+   * are locked upon construction and unlocked upon destruction (or move). It supports
+   * both regular locking and non-blocking `try_lock` semantics.
+   *
+   * The guard stores exactly one word per rmutex: its address. Locks and data are
+   * derived from those addresses, and whether the guard owns the locks is kept in
+   * bit 0 of the first one (every rmutex is at least 2-aligned). A guard of N rmutexes
+   * is therefore N pointers wide, and moving it copies N words.
    *
    * @tparam Ts A variadic template parameter pack, where each type `T` must be an rmutex instance.
    * @requires all_are_rmutex<Ts...> Ensures that all types in the pack are indeed rmutex types.
@@ -40,59 +53,88 @@ namespace rmutexpp {
   template <typename... Ts>
     requires all_are_rmutex<Ts...>
   class rmutex_guard {
+      template <std::size_t I>
+      using rmutex_at = std::tuple_element_t<I, std::tuple<Ts...>>;
+
       // Data members
-      /// @brief A tuple of unique_lock objects, one for each rmutex.
+      /// @brief The addresses of the guarded rmutex objects; bit 0 of the first one is the ownership flag.
       /// @note This member is mutable to allow locking operations in const methods.
-      mutable std::tuple<std::unique_lock<rmutex_mutex_type_t<Ts>>...> _locks;
+      mutable std::uintptr_t _mutexes[sizeof...(Ts)];
 
-      /// @brief A tuple of references to the rmutex objects being guarded.
-      std::tuple<Ts&...> _mutex_refs;
+      /// @brief The I-th guarded rmutex, with the ownership flag masked off.
+      template <std::size_t I>
+      rmutex_at<I>& mutex_at() const noexcept {
+        return *reinterpret_cast<rmutex_at<I>*>(_mutexes[I] & ~detail::guard_owned_bit);
+      }
 
-      /// @brief A flag indicating whether the guard currently owns the locks.
-      /// @note This member is mutable to allow modification by const methods like try_lock_all.
-      mutable bool _owns_locks;
+      bool owns_locks() const noexcept { return (_mutexes[0] & detail::guard_owned_bit) != 0; }
+
+      void set_owns_locks(bool owns) const noexcept {
+        _mutexes[0] = (_mutexes[0] & ~detail::guard_owned_bit) | (owns ? detail::guard_owned_bit : 0);
+      }
 
       // Helper to lock all rmutex objects
       /**
        * @brief Locks all rmutex objects managed by this guard.
        *
        * This private helper function uses `std::lock` to acquire locks on all
-       * mutexes in the `_locks` tuple. `std::lock` is used to prevent deadlocks
+       * guarded mutexes. `std::lock` is used to prevent deadlocks
        * when locking multiple mutexes.
        *
-       * @tparam Is A parameter pack of indices used to iterate over the `_locks` tuple.
+       * @tparam Is A parameter pack of indices used to iterate over the guarded rmutex objects.
        * @param index_sequence A `std::index_sequence` to unpack the indices.
        */
       template <std::size_t... Is>
       void lock_all(std::index_sequence<Is...>) const& {
         // Lock in order to avoid deadlocks
-        std::lock(std::get<Is>(_locks)...);
-        _owns_locks = true;
+        std::lock(mutex_at<Is>().lockable()...);
+        set_owns_locks(true);
       }
 
-      // template <std::size_t... Is>
-      // void unlock_all(std::index_sequence<Is...>) {
-      //   if (_owns_locks) {
-      //     (std::get<sizeof...(Is) - Is - 1>(_locks).unlock(), ...);
-      //     // Using fold expression (C++17) to unlock in reverse order
-      //   }
-      // }
+      /**
+       * @brief Releases every held lock, in reverse order of the guarded rmutex objects.
+       *
+       * @tparam Is A parameter pack of indices used to iterate over the guarded rmutex objects.
+       * @param index_sequence A `std::index_sequence` to unpack the indices.
+       */
+      template <std::size_t... Is>
+      void unlock_all(std::index_sequence<Is...>) {
+        if (owns_locks()) {
+          (mutex_at<sizeof...(Is) - Is - 1>().lockable().unlock(), ...);
+          set_owns_locks(false);
+        }
+      }
+
+      /// @brief Unlocks everything held, then destroys the objects deferred through this guard.
+      void release() noexcept {
+        if (owns_locks()) {
+          unlock_all(std::index_sequence_for<Ts...> {});
+          if (detail::deferred_pending() && !detail::still_held_by_caller(mutex_at<0>().lockable())) {
+            detail::flush_deferred(deferral_owner());
+          }
+        }
+      }
+
+      /// @brief The tag of objects deferred through this guard: the data of the first rmutex.
+      const void* deferral_owner() const noexcept { return &mutex_at<0>()._internal_data; }
 
       /**
        * @brief Attempts to lock all rmutex objects managed by this guard without blocking.
        *
        * This private helper function uses `std::try_lock` to attempt to acquire
-       * locks on all mutexes in the `_locks` tuple. If all locks are acquired,
-       * `_owns_locks` is set to true.
+       * locks on all guarded mutexes. If all locks are acquired, the ownership
+       * flag is set.
        *
-       * @tparam Is A parameter pack of indices used to iterate over the `_locks` tuple.
+       * @tparam Is A parameter pack of indices used to iterate over the guarded rmutex objects.
        * @param index_sequence A `std::index_sequence` to unpack the indices.
        * @return True if all locks were successfully acquired, false otherwise.
        */
       template <std::size_t... Is>
       bool try_lock_all(std::index_sequence<Is...>) const& {
         // std::try_lock returns -1 on success, or the index of the mutex that failed to lock.
-        return _owns_locks = (std::try_lock(std::get<Is>(_locks)...) == -1);
+        bool acquired = std::try_lock(mutex_at<Is>().lockable()...) == -1;
+        set_owns_locks(acquired);
+        return acquired;
       }
 
       /**
@@ -108,7 +150,7 @@ namespace rmutexpp {
        */
       template <std::size_t... Is>
       std::tuple<rmutex_data_type_t<Ts>&...> tuple_of_refs(std::index_sequence<Is...>) & {
-        return std::tie((std::get<Is>(_mutex_refs)._internal_data)...);
+        return std::tie((mutex_at<Is>()._internal_data)...);
       }
 
       /**
@@ -124,7 +166,7 @@ namespace rmutexpp {
        */
       template <std::size_t... Is>
       std::tuple<const rmutex_data_type_t<Ts>&...> tuple_of_refs(std::index_sequence<Is...>) const& {
-        return std::tie((std::get<Is>(_mutex_refs)._internal_data)...);
+        return std::tie((mutex_at<Is>()._internal_data)...);
       }
 
     public:
@@ -139,10 +181,7 @@ namespace rmutexpp {
        * @pre All `mutexes` must be valid rmutex instances.
        * @post All rmutex objects are locked, and `owns()` returns true.
        */
-      [[nodiscard]] explicit rmutex_guard(Ts&... mutexes):
-          _owns_locks(false),
-          _locks(std::make_tuple(std::unique_lock<rmutex_mutex_type_t<Ts>>(mutexes._internal_mutex, std::defer_lock)...)),
-          _mutex_refs(mutexes...) {
+      [[nodiscard]] explicit rmutex_guard(Ts&... mutexes): _mutexes { reinterpret_cast<std::uintptr_t>(&mutexes)... } {
         lock_all(std::index_sequence_for<Ts...> {});
       }
 
@@ -158,23 +197,18 @@ namespace rmutexpp {
        * @pre All `mutexes` must be valid rmutex instances.
        * @post `owns()` reflects whether all rmutex objects were successfully locked.
        */
-      [[nodiscard]] rmutex_guard(std::try_to_lock_t tag, Ts&... mutexes):
-          _owns_locks(false),
-          _locks(std::make_tuple(std::unique_lock<rmutex_mutex_type_t<Ts>>(mutexes._internal_mutex, std::defer_lock)...)),
-          _mutex_refs(mutexes...) {
+      [[nodiscard]] rmutex_guard(std::try_to_lock_t, Ts&... mutexes): _mutexes { reinterpret_cast<std::uintptr_t>(&mutexes)... } {
         try_lock_all(std::index_sequence_for<Ts...> {});
       }
 
-      // Default constructor
-      // [[nodiscard]] rmutex_guard(): _owns_locks(false) { }
-
       /**
        * @brief Destructor for rmutex_guard.
        *
        * When the `rmutex_guard` object is destroyed, it automatically releases
-       * any locks it currently owns. This ensures RAII compliance.
+       * any locks it currently owns. This ensures RAII compliance. Objects passed to
+       * `defer_after_unlock()` or `retire()` are destroyed after every lock is released.
        */
-      ~rmutex_guard() = default;
+      ~rmutex_guard() { release(); }
 
       /**
        * @brief Move constructor for rmutex_guard.
@@ -184,9 +218,9 @@ namespace rmutexpp {
        *
        * @param other The rmutex_guard object to move from.
        */
-      rmutex_guard(rmutex_guard&& other) noexcept:
-          _locks(std::move(other._locks)), _mutex_refs(std::move(other._mutex_refs)), _owns_locks(other._owns_locks) {
-        other._owns_locks = false;
+      rmutex_guard(rmutex_guard&& other) noexcept {
+        std::copy(std::begin(other._mutexes), std::end(other._mutexes), _mutexes);
+        other.set_owns_locks(false);
       }
 
       /**
@@ -201,10 +235,9 @@ namespace rmutexpp {
        */
       rmutex_guard& operator=(rmutex_guard&& other) noexcept {
         if (this != &other) {
-          _locks            = std::move(other._locks);
-          _mutex_refs       = std::move(other._mutex_refs);
-          _owns_locks       = other._owns_locks;
-          other._owns_locks = false;
+          release();
+          std::copy(std::begin(other._mutexes), std::end(other._mutexes), _mutexes);
+          other.set_owns_locks(false);
         }
         return *this;
       }
@@ -219,13 +252,13 @@ namespace rmutexpp {
        * @brief Checks if the rmutex_guard currently owns all its locks.
        * @return True if all locks are held, false otherwise.
        */
-      bool owns() const& noexcept { return _owns_locks; }
+      bool owns() const& noexcept { return owns_locks(); }
 
       /**
        * @brief Conversion operator to bool.
        * @return True if the rmutex_guard currently owns all its locks, false otherwise.
        */
-      explicit operator bool() const& noexcept { return _owns_locks; }
+      explicit operator bool() const& noexcept { return owns_locks(); }
 
       /// @brief Deleted rvalue reference version of owns() to prevent temporary access.
       bool owns() const&& = delete;
@@ -236,19 +269,21 @@ namespace rmutexpp {
       /**
        * @brief Attempts to acquire all locks without blocking.
        *
-       * This method can be called on an existing rmutex_guard object that might
-       * not currently own its locks (e.g., if constructed with `std::defer_lock`
-       * or if a previous `try_lock` failed).
+       * This method can be called on an existing rmutex_guard object that does
+       * not currently own its locks (e.g., if a previous `try_lock` failed).
        *
        * @return True if all locks were successfully acquired, false otherwise.
+       * @pre The guard does not own its locks.
        */
       bool try_lock() const& { return try_lock_all(std::index_sequence_for<Ts...> {}); }
 
       /**
        * @brief Acquires all locks, blocking if necessary.
        *
-       * This method can be called on an existing rmutex_guard object that might
+       * This method can be called on an existing rmutex_guard object that does
        * not currently own its locks. It will block until all locks are acquired.
+       *
+       * @pre The guard does not own its locks.
        */
       void lock() const& { lock_all(std::index_sequence_for<Ts...> {}); }
 
@@ -263,7 +298,7 @@ namespace rmutexpp {
        * to the data if locks are owned, otherwise `std::nullopt`.
        */
       std::optional<std::tuple<rmutex_data_type_t<Ts>&...>> get_data() & {
-        if (_owns_locks) {
+        if (owns_locks()) {
           return tuple_of_refs(std::index_sequence_for<Ts...> {});
         } else {
           return std::nullopt;
@@ -281,7 +316,7 @@ namespace rmutexpp {
        * to the data if locks are owned, otherwise `std::nullopt`.
        */
       std::optional<std::tuple<const rmutex_data_type_t<Ts>&...>> get_data() const& {
-        if (_owns_locks) {
+        if (owns_locks()) {
           return tuple_of_refs(std::index_sequence_for<Ts...> {});
         } else {
           return std::nullopt;
@@ -293,6 +328,36 @@ namespace rmutexpp {
 
       /// @brief Deleted const rvalue reference version of get_data() to prevent temporary access.
       std::optional<std::tuple<const rmutex_data_type_t<Ts>&...>> get_data() const&& = delete;
+
+      /**
+       * @brief Takes ownership of an object removed from the guarded data and destroys it
+       * after the guard releases its locks, or right away if it holds none.
+       * @param doomed The object to destroy; must be an rvalue.
+       * @sa rmutex_ref::defer_after_unlock()
+       */
+      template <typename U>
+        requires(!std::is_lvalue_reference_v<U>)
+      void defer_after_unlock(U&& doomed) & {
+        if (owns_locks()) {
+          detail::defer_destruction(deferral_owner(), nullptr, std::move(doomed));
+        } else {
+          detail::destroy_undeferred(nullptr, std::move(doomed));
+        }
+      }
+
+      /**
+       * @brief Like `defer_after_unlock()`, but the object is destroyed on `reclaimer`'s thread.
+       * @sa rmutex_ref::retire()
+       */
+      template <typename U>
+        requires(!std::is_lvalue_reference_v<U>)
+      void retire(U&& doomed, background_reclaimer& reclaimer) & {
+        if (owns_locks()) {
+          detail::defer_destruction(deferral_owner(), &reclaimer, std::move(doomed));
+        } else {
+          detail::destroy_undeferred(&reclaimer, std::move(doomed));
+        }
+      }
   };
 
   /**
@@ -301,7 +366,8 @@ namespace rmutexpp {
    *
    * This specialization of rmutex_guard provides an optimized implementation for
    * managing a single rmutex instance. It behaves similarly to `std::unique_lock`
-   * but provides direct access to the rmutex's protected data.
+   * but provides direct access to the rmutex's protected data. Like the primary
+   * template it is one pointer wide, with the ownership flag in bit 0.
    *
    * @tparam T The type of the single rmutex object to be guarded.
    * @requires all_are_rmutex<T> Ensures that `T` is an rmutex type.
@@ -309,16 +375,26 @@ namespace rmutexpp {
   template <typename T>
     requires all_are_rmutex<T>
   class rmutex_guard<T> {
-      /// @brief The unique_lock object managing the single rmutex.
+      /// @brief The address of the guarded rmutex; bit 0 is the ownership flag.
       /// @note This member is mutable to allow locking operations in const methods.
-      mutable std::unique_lock<std::mutex> _lock;
+      mutable std::uintptr_t _mutex;
 
-      /// @brief A reference to the internal data of the guarded rmutex.
-      rmutex_data_type_t<T>& _data_ref;
+      T& mutex() const noexcept { return *reinterpret_cast<T*>(_mutex & ~detail::guard_owned_bit); }
 
-      /// @brief A flag indicating whether the guard currently owns the lock.
-      /// @note This member is mutable to allow modification by const methods like try_lock.
-      mutable bool _owns_lock;
+      bool owns_lock() const noexcept { return (_mutex & detail::guard_owned_bit) != 0; }
+
+      void set_owns_lock(bool owns) const noexcept { _mutex = (_mutex & ~detail::guard_owned_bit) | (owns ? detail::guard_owned_bit : 0); }
+
+      /// @brief Unlocks the rmutex if held, then destroys the objects deferred through this guard.
+      void release() noexcept {
+        if (owns_lock()) {
+          set_owns_lock(false);
+          mutex().lockable().unlock();
+          if (detail::deferred_pending() && !detail::still_held_by_caller(mutex().lockable())) {
+            detail::flush_deferred(&mutex()._internal_data);
+          }
+        }
+      }
 
     public:
       /**
@@ -331,13 +407,13 @@ namespace rmutexpp {
        * @pre `mutex` must be a valid rmutex instance.
        * @post The rmutex is locked, and `owns()` returns true.
        */
-      [[nodiscard]] explicit rmutex_guard(T& mutex): _owns_lock(true), _lock(mutex._internal_mutex), _data_ref(mutex._internal_data) { }
+      [[nodiscard]] explicit rmutex_guard(T& mutex): _mutex(reinterpret_cast<std::uintptr_t>(&mutex)) { lock(); }
 
       /**
        * @brief Constructs an rmutex_guard for a single rmutex and attempts to lock it.
        *
-       * This constructor attempts to acquire a lock on the provided `mutex` using
-       * `std::try_to_lock`. It does not block if the lock cannot be acquired.
+       * This constructor attempts to acquire a lock on the provided `mutex`.
+       * It does not block if the lock cannot be acquired.
        * The `owns()` method can be used to check if the lock was successfully obtained.
        *
        * @param tag A `std::try_to_lock_t` tag to indicate non-blocking try-lock semantics.
@@ -345,21 +421,16 @@ namespace rmutexpp {
        * @pre `mutex` must be a valid rmutex instance.
        * @post `owns()` reflects whether the rmutex was successfully locked.
        */
-      [[nodiscard]] rmutex_guard(std::try_to_lock_t tag, T& mutex):
-          _owns_lock(false), _lock(mutex._internal_mutex, std::try_to_lock), _data_ref(mutex._internal_data) {
-        _owns_lock = _lock.owns_lock();
-      }
-
-      // Default constructor
-      // [[nodiscard]] rmutex_guard(): _owns_locks(false) { }
+      [[nodiscard]] rmutex_guard(std::try_to_lock_t, T& mutex): _mutex(reinterpret_cast<std::uintptr_t>(&mutex)) { try_lock(); }
 
       /**
        * @brief Destructor for rmutex_guard specialization.
        *
        * When the `rmutex_guard` object is destroyed, it automatically releases
-       * the lock it currently owns. This ensures RAII compliance.
+       * the lock it currently owns. This ensures RAII compliance. Objects passed to
+       * `defer_after_unlock()` or `retire()` are destroyed after the lock is released.
        */
-      ~rmutex_guard() = default;
+      ~rmutex_guard() { release(); }
 
       /**
        * @brief Move constructor for rmutex_guard specialization.
@@ -369,9 +440,7 @@ namespace rmutexpp {
        *
        * @param other The rmutex_guard object to move from.
        */
-      rmutex_guard(rmutex_guard&& other) noexcept: _lock(std::move(other._lock)), _data_ref(other._data_ref), _owns_lock(other._owns_lock) {
-        other._owns_lock = false;
-      }
+      rmutex_guard(rmutex_guard&& other) noexcept: _mutex(other._mutex) { other.set_owns_lock(false); }
 
       /**
        * @brief Move assignment operator for rmutex_guard specialization.
@@ -385,10 +454,9 @@ namespace rmutexpp {
        */
       rmutex_guard& operator=(rmutex_guard&& other) noexcept {
         if (this != &other) {
-          _lock            = std::move(other._lock);
-          _data_ref        = other._data_ref;  // Data reference is copied, not moved, as it refers to external data
-          _owns_lock       = other._owns_lock;
-          other._owns_lock = false;
+          release();
+          _mutex = other._mutex;
+          other.set_owns_lock(false);
         }
         return *this;
       }
@@ -403,13 +471,13 @@ namespace rmutexpp {
        * @brief Checks if the rmutex_guard currently owns its lock.
        * @return True if the lock is held, false otherwise.
        */
-      bool owns() const& noexcept { return _owns_lock; }
+      bool owns() const& noexcept { return owns_lock(); }
 
       /**
        * @brief Conversion operator to bool.
        * @return True if the rmutex_guard currently owns its lock, false otherwise.
        */
-      explicit operator bool() const& noexcept { return _owns_lock; }
+      explicit operator bool() const& noexcept { return owns_lock(); }
 
       /// @brief Deleted rvalue reference version of owns() to prevent temporary access.
       bool owns() const&& = delete;
@@ -420,37 +488,44 @@ namespace rmutexpp {
       /**
        * @brief Attempts to acquire the lock without blocking.
        *
-       * This method can be called on an existing rmutex_guard object that might
+       * This method can be called on an existing rmutex_guard object that does
        * not currently own its lock.
        *
        * @return True if the lock was successfully acquired, false otherwise.
+       * @pre The guard does not own its lock.
        */
-      bool try_lock() const& { return _owns_lock = _lock.try_lock(); }
+      bool try_lock() const& {
+        bool acquired = mutex().lockable().try_lock();
+        set_owns_lock(acquired);
+        return acquired;
+      }
 
       /**
        * @brief Acquires the lock, blocking if necessary.
        *
-       * This method can be called on an existing rmutex_guard object that might
+       * This method can be called on an existing rmutex_guard object that does
        * not currently own its lock. It will block until the lock is acquired.
+       *
+       * @pre The guard does not own its lock.
        */
       void lock() const& {
-        _lock.lock();
-        _owns_lock = true;
+        mutex().lockable().lock();
+        set_owns_lock(true);
       }
 
       /**
        * @brief Provides access to the guarded data as a non-const reference.
        *
-       * This method returns an `std::optional` containing a non-const reference
+       * This method returns an `std::optional` containing a reference wrapper
        * to the internal data of the rmutex object, but only if the guard
        * currently owns its lock.
        *
-       * @return An `std::optional` containing a non-const reference to the data
+       * @return An `std::optional` containing a reference to the data
        * if the lock is owned, otherwise `std::nullopt`.
        */
-      std::optional<rmutex_data_type_t<T>&> get_data() & {
-        if (_owns_lock) {
-          return _data_ref;
+      std::optional<std::reference_wrapper<rmutex_data_type_t<T>>> get_data() & {
+        if (owns_lock()) {
+          return std::ref(mutex()._internal_data);
         } else {
           return std::nullopt;
         }
@@ -459,26 +534,48 @@ namespace rmutexpp {
       /**
        * @brief Provides access to the guarded data as a const reference.
        *
-       * This method returns an `std::optional` containing a const reference
+       * This method returns an `std::optional` containing a const reference wrapper
        * to the internal data of the rmutex object, but only if the guard
        * currently owns its lock.
        *
        * @return An `std::optional` containing a const reference to the data
        * if the lock is owned, otherwise `std::nullopt`.
        */
-      std::optional<const rmutex_data_type_t<T>&> get_data() const& {
-        if (_owns_lock) {
-          return std::cref(_data_ref);
+      std::optional<std::reference_wrapper<const rmutex_data_type_t<T>>> get_data() const& {
+        if (owns_lock()) {
+          return std::cref(mutex()._internal_data);
         } else {
           return std::nullopt;
         }
       }
 
       /// @brief Deleted rvalue reference version of get_data() to prevent temporary access.
-      std::optional<rmutex_data_type_t<T>&> get_data() && = delete;
+      std::optional<std::reference_wrapper<rmutex_data_type_t<T>>> get_data() && = delete;
 
       /// @brief Deleted const rvalue reference version of get_data() to prevent temporary access.
-      std::optional<const rmutex_data_type_t<T>&> get_data() const&& = delete;
+      std::optional<std::reference_wrapper<const rmutex_data_type_t<T>>> get_data() const&& = delete;
+
+      /// @copydoc rmutex_guard::defer_after_unlock
+      template <typename U>
+        requires(!std::is_lvalue_reference_v<U>)
+      void defer_after_unlock(U&& doomed) & {
+        if (owns_lock()) {
+          detail::defer_destruction(&mutex()._internal_data, nullptr, std::move(doomed));
+        } else {
+          detail::destroy_undeferred(nullptr, std::move(doomed));
+        }
+      }
+
+      /// @copydoc rmutex_guard::retire
+      template <typename U>
+        requires(!std::is_lvalue_reference_v<U>)
+      void retire(U&& doomed, background_reclaimer& reclaimer) & {
+        if (owns_lock()) {
+          detail::defer_destruction(&mutex()._internal_data, &reclaimer, std::move(doomed));
+        } else {
+          detail::destroy_undeferred(&reclaimer, std::move(doomed));
+        }
+      }
   };
 
   /**
@@ -505,5 +602,28 @@ namespace rmutexpp {
    */
   template <typename... Ts>
   rmutex_guard(std::try_to_lock_t, Ts&... args) -> rmutex_guard<Ts...>;
+
+  /**
+   * @brief Locks every rmutex with the deadlock avoidance of `rmutex_guard`, runs `fn` on
+   * their data and unlocks them.
+   *
+   * The lambda counterpart of `rmutex_guard` (as `rmutex::with_lock` is for `rmutex_ref`):
+   * no `std::optional<std::tuple<...>>` is built and no owns flag is tested, so the
+   * critical section inlines into the caller.
+   *
+   * @code
+   * with_locks([](account& from, account& to) { from.balance -= 10; to.balance += 10; }, alice, bob);
+   * @endcode
+   *
+   * @param fn Callable invoked with a reference to the data of each rmutex, in argument order.
+   * @param mutexes The rmutex objects to lock.
+   * @return Whatever `fn` returns.
+   */
+  template <typename Fn, typename... Ts>
+    requires(sizeof...(Ts) > 0 && all_are_rmutex<Ts...> && std::invocable<Fn, rmutex_data_type_t<Ts>&...>)
+  RMUTEX_ALWAYS_INLINE decltype(auto) with_locks(Fn&& fn, Ts&... mutexes) {
+    std::scoped_lock lock(detail::rmutex_access::mutex(mutexes)...);
+    return std::invoke(std::forward<Fn>(fn), detail::rmutex_access::data(mutexes)...);
+  }
 }  // namespace rmutexpp
 #endif  // _RMUTEX_GUARD_HEADER_
@@ -0,0 +1,237 @@
+/**
+ * @file shared_rmutex.hpp
+ * @brief Defines shared_rmutex and weak_rmutex, a reference-counted rmutex whose counts,
+ * lock and data live in one allocation.
+ *
+ * `std::shared_ptr<rmutex<T>>` allocates a control block next to the rmutex (or lays
+ * both out generically with `make_shared`) and supports type erasure, custom deleters
+ * and aliasing that an rmutex never needs. `make_shared_rmutex<T>(args...)` allocates a
+ * single block:
+ *
+ * | strong count | weak count | lock | T |
+ *
+ * Copying a `shared_rmutex` is one relaxed increment of the strong count. The last
+ * strong handle destroys the rmutex; the block itself is freed once the last
+ * `weak_rmutex` is gone too.
+ */
+#ifndef _SHARED_RMUTEX_HEADER_
+#define _SHARED_RMUTEX_HEADER_
+
+#include <atomic>    // For std::atomic
+#include <cstddef>   // For std::size_t, std::nullptr_t
+#include <memory>    // For std::addressof, std::destroy_at
+#include <mutex>     // For std::mutex
+#include <new>       // For placement new
+#include <optional>  // For std::optional
+#include <utility>   // For std::exchange, std::forward, std::in_place, std::swap
+
+#include "rmutex.hpp"  // For rmutex, rmutex_ref
+
+namespace rmutexpp {
+  template <typename T, typename Mutex = std::mutex>
+  class shared_rmutex;
+
+  template <typename T, typename Mutex = std::mutex>
+  class weak_rmutex;
+
+  template <typename T, typename Mutex = std::mutex, typename... Args>
+  [[nodiscard]] shared_rmutex<T, Mutex> make_shared_rmutex(Args&&... args);
+
+  namespace detail {
+    template <typename T, typename Mutex>
+    struct shared_rmutex_block {
+        std::atomic<std::size_t> strong { 1 };
+        std::atomic<std::size_t> weak { 1 };  ///< The strong handles together hold one weak count.
+
+        union {
+            rmutex<T, Mutex> mutex;
+        };
+
+        template <typename... Args>
+        explicit shared_rmutex_block(Args&&... args) {
+          ::new (static_cast<void*>(std::addressof(mutex))) rmutex<T, Mutex>(std::in_place, std::forward<Args>(args)...);
+        }
+
+        ~shared_rmutex_block() { }
+
+        void release_weak() noexcept {
+          if (weak.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+          }
+        }
+
+        void release_strong() noexcept {
+          // No shortcut for a seemingly sole handle: reading the two counts separately races
+          // with a weak handle that upgrades and then drops itself in between.
+          // Acquire on the last decrement: every other handle's last use of the data happens before the destruction.
+          if (strong.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::destroy_at(std::addressof(mutex));
+            release_weak();
+          }
+        }
+    };
+  }  // namespace detail
+
+  /**
+   * @class shared_rmutex
+   * @brief A shared handle to an rmutex allocated together with its reference counts.
+   * @tparam T The type of data protected by the rmutex.
+   * @tparam Mutex The lock backend of the rmutex.
+   *
+   * Offers the `lock()`/`try_lock()`/`with_lock()` API of the rmutex it points to, and
+   * `*`/`->` for the rest. A `rmutex_ref` obtained through it points into the block,
+   * so keep a handle alive for as long as the ref.
+   *
+   * @code
+   * auto jobs = make_shared_rmutex<std::deque<job>>();
+   * std::thread worker([jobs] { while (auto next = pop(jobs->lock())) run(*next); });
+   * jobs.lock()->push_back(job { "first" });
+   * @endcode
+   */
+  template <typename T, typename Mutex>
+  class shared_rmutex {
+      using block_type = detail::shared_rmutex_block<T, Mutex>;
+
+      block_type* _block = nullptr;
+
+      explicit shared_rmutex(block_type* block) noexcept: _block(block) { }
+
+      template <typename U, typename M, typename... Args>
+      friend shared_rmutex<U, M> make_shared_rmutex(Args&&... args);
+
+      friend class weak_rmutex<T, Mutex>;
+
+    public:
+      /// @brief An empty handle.
+      constexpr shared_rmutex() noexcept = default;
+
+      constexpr shared_rmutex(std::nullptr_t) noexcept { }
+
+      /// @brief Shares the rmutex of `other`: one relaxed increment.
+      shared_rmutex(const shared_rmutex& other) noexcept: _block(other._block) {
+        if (_block) {
+          // Relaxed is enough: `other` keeps the block alive while we increment.
+          _block->strong.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+
+      shared_rmutex(shared_rmutex&& other) noexcept: _block(std::exchange(other._block, nullptr)) { }
+
+      shared_rmutex& operator=(const shared_rmutex& other) noexcept {
+        shared_rmutex(other).swap(*this);
+        return *this;
+      }
+
+      shared_rmutex& operator=(shared_rmutex&& other) noexcept {
+        shared_rmutex(std::move(other)).swap(*this);
+        return *this;
+      }
+
+      ~shared_rmutex() {
+        if (_block) {
+          _block->release_strong();
+        }
+      }
+
+      void swap(shared_rmutex& other) noexcept { std::swap(_block, other._block); }
+
+      /// @brief Drops this handle's share, leaving it empty.
+      void reset() noexcept { shared_rmutex().swap(*this); }
+
+      /// @brief Locks the shared rmutex. @pre The handle is not empty.
+      [[nodiscard]] rmutex_ref<T, Mutex> lock() const { return _block->mutex.lock(); }
+
+      /// @brief Attempts to lock the shared rmutex. @pre The handle is not empty.
+      [[nodiscard]] std::optional<rmutex_ref<T, Mutex>> try_lock() const { return _block->mutex.try_lock(); }
+
+      /// @brief Runs `fn` on the data under the lock, see `rmutex::with_lock()`. @pre The handle is not empty.
+      template <typename Fn>
+        requires std::invocable<Fn, T&>
+      RMUTEX_ALWAYS_INLINE decltype(auto) with_lock(Fn&& fn) const {
+        return _block->mutex.with_lock(std::forward<Fn>(fn));
+      }
+
+      rmutex<T, Mutex>& operator*() const noexcept { return _block->mutex; }
+
+      rmutex<T, Mutex>* operator->() const noexcept { return std::addressof(_block->mutex); }
+
+      explicit operator bool() const noexcept { return _block != nullptr; }
+
+      /// @brief The number of strong handles; only a hint while other threads copy or drop handles.
+      std::size_t use_count() const noexcept { return _block ? _block->strong.load(std::memory_order_relaxed) : 0; }
+
+      friend bool operator==(const shared_rmutex& a, const shared_rmutex& b) noexcept { return a._block == b._block; }
+  };
+
+  /**
+   * @class weak_rmutex
+   * @brief A non-owning handle to a `shared_rmutex`: it keeps the block, not the data, alive.
+   * @tparam T The type of data protected by the rmutex.
+   * @tparam Mutex The lock backend of the rmutex.
+   */
+  template <typename T, typename Mutex>
+  class weak_rmutex {
+      using block_type = detail::shared_rmutex_block<T, Mutex>;
+
+      block_type* _block = nullptr;
+
+    public:
+      constexpr weak_rmutex() noexcept = default;
+
+      weak_rmutex(const shared_rmutex<T, Mutex>& shared) noexcept: _block(shared._block) {
+        if (_block) {
+          _block->weak.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+
+      weak_rmutex(const weak_rmutex& other) noexcept: _block(other._block) {
+        if (_block) {
+          _block->weak.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+
+      weak_rmutex(weak_rmutex&& other) noexcept: _block(std::exchange(other._block, nullptr)) { }
+
+      weak_rmutex& operator=(weak_rmutex other) noexcept {
+        std::swap(_block, other._block);
+        return *this;
+      }
+
+      ~weak_rmutex() {
+        if (_block) {
+          _block->release_weak();
+        }
+      }
+
+      /**
+       * @brief Gets a strong handle, if the rmutex is still alive.
+       * @return The handle, or an empty handle once the last strong handle is gone.
+       */
+      [[nodiscard]] shared_rmutex<T, Mutex> upgrade() const noexcept {
+        if (!_block) {
+          return { };
+        }
+        std::size_t strong = _block->strong.load(std::memory_order_relaxed);
+        while (strong != 0) {
+          if (_block->strong.compare_exchange_weak(strong, strong + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return shared_rmutex<T, Mutex>(_block);
+          }
+        }
+        return { };
+      }
+
+      /// @brief Whether the rmutex has been destroyed; only a hint while other threads drop handles.
+      bool expired() const noexcept { return !_block || _block->strong.load(std::memory_order_relaxed) == 0; }
+  };
+
+  /**
+   * @brief Allocates an rmutex and its reference counts in one block.
+   * @param args Arguments forwarded to the constructor of `T`.
+   * @return The first strong handle.
+   */
+  template <typename T, typename Mutex, typename... Args>
+  shared_rmutex<T, Mutex> make_shared_rmutex(Args&&... args) {
+    return shared_rmutex<T, Mutex>(new detail::shared_rmutex_block<T, Mutex>(std::forward<Args>(args)...));
+  }
+}  // namespace rmutexpp
+#endif  // _SHARED_RMUTEX_HEADER_
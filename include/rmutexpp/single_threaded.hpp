@@ -0,0 +1,92 @@
+/**
+ * @file single_threaded.hpp
+ * @brief Defines the process-wide single-threaded mode, in which the lock backends of
+ * `rmutex_backends.hpp` skip their atomic read-modify-write operations.
+ *
+ * Programs often spend their first seconds loading data on the main thread before any
+ * other thread exists. Every lock taken then still pays for an atomic exchange or
+ * compare-exchange. Calling `enter_single_threaded_mode()` at the start of such a
+ * phase turns `spin_mutex` and `word_mutex` into plain loads and stores of their lock
+ * words until the mode is left, which happens:
+ *
+ * - explicitly, through `leave_single_threaded_mode()`;
+ * - automatically, when a `rmutexpp::thread` is started.
+ *
+ * Starting a thread any other way (plain `std::thread`, `pthread_create`, a thread
+ * pool) while the mode is on is a bug: `RMUTEX_ASSERT` catches a lock taken by any
+ * thread other than the one that entered the mode, and a lock re-taken while held.
+ *
+ * `std::mutex` is not affected; the mode only applies to the library's own backends.
+ */
+#ifndef _SINGLE_THREADED_HEADER_
+#define _SINGLE_THREADED_HEADER_
+
+#include <atomic>       // For std::atomic
+#include <cassert>      // For assert
+#include <thread>       // For std::thread, std::this_thread::get_id
+#include <type_traits>  // For std::is_same_v, std::remove_cvref_t
+#include <utility>      // For std::forward
+
+/**
+ * @def RMUTEX_ASSERT
+ * @brief Debug check used by the library. Define it before including any rmutexpp header
+ * to route the checks elsewhere; by default it is `assert` (so it vanishes with `NDEBUG`).
+ */
+#ifndef RMUTEX_ASSERT
+#define RMUTEX_ASSERT(condition, message) assert((condition) && message)
+#endif
+
+namespace rmutexpp {
+  namespace detail {
+    // Relaxed is enough: the mode is only entered or left while a single thread runs,
+    // and starting a thread synchronizes it with everything its creator did before.
+    inline std::atomic<bool>            single_threaded_flag { false };
+    inline std::atomic<std::thread::id> single_threaded_owner {};
+
+    /// @brief Whether the calling thread may use the elided paths; only evaluated in debug checks.
+    inline bool single_threaded_caller() noexcept {
+      return single_threaded_owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+  }  // namespace detail
+
+  /// @brief Whether the process is in single-threaded mode.
+  inline bool single_threaded() noexcept { return detail::single_threaded_flag.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Enters single-threaded mode on the calling thread.
+   * @pre No other thread that may lock an rmutex is running.
+   */
+  inline void enter_single_threaded_mode() noexcept {
+    detail::single_threaded_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    detail::single_threaded_flag.store(true, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Leaves single-threaded mode; locks taken from now on use atomic operations again.
+   *
+   * Locks held at this point stay valid: in both modes a held lock is stored in its lock
+   * word the same way.
+   */
+  inline void leave_single_threaded_mode() noexcept {
+    RMUTEX_ASSERT(!single_threaded() || detail::single_threaded_caller(), "single-threaded mode left from another thread");
+    detail::single_threaded_flag.store(false, std::memory_order_relaxed);
+  }
+
+  /**
+   * @class thread
+   * @brief A `std::thread` that leaves single-threaded mode before it starts.
+   *
+   * Use it instead of `std::thread` in programs with a single-threaded phase: the first
+   * thread created ends the phase automatically.
+   */
+  class thread : public std::thread {
+    public:
+      thread() noexcept = default;
+
+      template <typename F, typename... Args>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, thread>)
+      explicit thread(F&& f, Args&&... args):
+          std::thread((leave_single_threaded_mode(), std::forward<F>(f)), std::forward<Args>(args)...) { }
+  };
+}  // namespace rmutexpp
+#endif  // _SINGLE_THREADED_HEADER_
@@ -0,0 +1,108 @@
+// rmutex_lib/test/chunked_iteration_unit_tests.cpp
+
+#include <map>            // For std::map
+#include <set>            // For std::set
+#include <string>         // For std::string
+#include <unordered_map>  // For std::unordered_map
+#include <vector>         // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/chunked_iteration.hpp"
+
+using namespace rmutexpp;
+
+TEST(chunked_iterationTest, VisitsEverythingInChunks) {
+  rmutex<std::vector<int>> values(std::vector<int>(1000, 1));
+  int                      sum   = 0;
+  chunked_stats            stats = for_each_chunked(values, 100, [&](int& value) { sum += value; });
+  EXPECT_EQ(sum, 1000);
+  EXPECT_EQ(stats.visited, 1000u);
+  EXPECT_EQ(stats.chunks, 10u);
+  EXPECT_EQ(stats.structural_changes, 0u);
+  EXPECT_TRUE(values.try_lock().has_value());  // Released after the scan.
+}
+
+// Ordered containers resume after the last key seen, so concurrent inserts never cause a revisit.
+TEST(chunked_iterationTest, OrderedCursorSurvivesInserts) {
+  rmutex<std::map<int, std::string>> names;
+  for (int key = 0; key < 100; key += 2) {
+    (*names.lock())[key] = "even";
+  }
+  chunked_scan          scan(names, 10);
+  std::multiset<int>    seen;
+  auto                  record = [&](auto& entry) { seen.insert(entry.first); };
+  ASSERT_TRUE(scan.next_chunk(record));
+  (*names.lock())[1]  = "odd, before the cursor";
+  (*names.lock())[51] = "odd, after the cursor";
+  while (scan.next_chunk(record)) {
+  }
+  EXPECT_EQ(seen.count(1), 0u);
+  EXPECT_EQ(seen.count(51), 1u);
+  EXPECT_EQ(seen.size(), 51u);
+  EXPECT_EQ(scan.stats().structural_changes, 0u);
+}
+
+// A rehash between chunks is detected; restart revisits from the start, skip carries on.
+TEST(chunked_iterationTest, RehashAppliesPolicy) {
+  for (chunk_policy policy : { chunk_policy::restart, chunk_policy::skip }) {
+    rmutex<std::unordered_map<int, int>> counters;
+    for (int key = 0; key < 1000; ++key) {
+      counters.lock()->emplace(key, 0);
+    }
+    chunked_scan scan(counters, 100, policy);
+    auto         bump = [](auto& entry) { ++entry.second; };
+    ASSERT_TRUE(scan.next_chunk(bump));
+    {
+      rmutex_ref map = counters.lock();
+      map->rehash(map->bucket_count() * 4);
+    }
+    while (scan.next_chunk(bump)) {
+    }
+    EXPECT_EQ(scan.stats().structural_changes, 1u);
+
+    int missed = 0;
+    int twice  = 0;
+    for (const auto& [key, count] : *counters.lock()) {
+      missed += count == 0 ? 1 : 0;
+      twice += count > 1 ? 1 : 0;
+    }
+    if (policy == chunk_policy::restart) {
+      EXPECT_EQ(missed, 0);
+      EXPECT_GT(twice, 0);
+    } else {
+      EXPECT_EQ(scan.stats().visited, 1000u - missed + twice);
+    }
+  }
+}
+
+// One insertion and one erasure between chunks leave size() unchanged: only a versioned container notices.
+TEST(chunked_iterationTest, NetZeroSizeChangeNeedsVersioned) {
+  auto insert_and_erase = [](std::vector<int>& values) {
+    values.insert(values.begin(), -1);
+    values.pop_back();
+  };
+
+  rmutex<std::vector<int>> plain(std::vector<int> { 0, 1, 2, 3, 4, 5 });
+  chunked_scan             plain_scan(plain, 2);
+  std::vector<int>         plain_seen;
+  auto                     record_plain = [&](int value) { plain_seen.push_back(value); };
+  ASSERT_TRUE(plain_scan.next_chunk(record_plain));
+  insert_and_erase(*plain.lock());
+  while (plain_scan.next_chunk(record_plain)) {
+  }
+  EXPECT_EQ(plain_scan.stats().structural_changes, 0u);
+  EXPECT_EQ(plain_seen, (std::vector<int> { 0, 1, 1, 2, 3, 4 }));  // 1 revisited, undetected.
+
+  rmutex<versioned<std::vector<int>>> tracked(versioned(std::vector<int> { 0, 1, 2, 3, 4, 5 }));
+  chunked_scan                        tracked_scan(tracked, 2);
+  std::vector<int>                    tracked_seen;
+  auto                                record_tracked = [&](int value) { tracked_seen.push_back(value); };
+  ASSERT_TRUE(tracked_scan.next_chunk(record_tracked));
+  insert_and_erase(tracked.lock()->modify());
+  while (tracked_scan.next_chunk(record_tracked)) {
+  }
+  EXPECT_EQ(tracked_scan.stats().structural_changes, 1u);
+  EXPECT_EQ(tracked_seen, (std::vector<int> { 0, 1, -1, 0, 1, 2, 3, 4 }));  // Restarted.
+  EXPECT_EQ(tracked.lock()->structural_version(), 1u);
+}
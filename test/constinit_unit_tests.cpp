@@ -0,0 +1,53 @@
+// rmutex_lib/test/constinit_unit_tests.cpp
+
+#include <mutex>   // For std::mutex
+#include <string>  // For std::string
+#include <vector>  // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/optimistic_lock.hpp"
+#include "rmutexpp/rmutex.hpp"
+#include "rmutexpp/rmutex_backends.hpp"
+
+using namespace rmutexpp;
+
+static_assert(constant_initializable_lockable<std::mutex>);
+static_assert(constant_initializable_lockable<spin_mutex>);
+static_assert(constant_initializable_lockable<word_mutex>);
+static_assert(constant_initializable_lockable<optimistic_lock>);
+
+namespace {
+  extern rmutex<std::vector<std::string>> registry;
+
+  // A dynamic initializer that runs before `registry` is declared: safe only because the
+  // registry is constant-initialized, i.e. ready before any dynamic initialization.
+  const bool registered_early = [] {
+    registry.lock()->push_back("early");
+    return true;
+  }();
+
+  struct bounds {
+      int low;
+      int high;
+  };
+
+  // Not constant-initializable: its constructor is not constexpr.
+  struct dynamic_mutex : std::mutex {
+      dynamic_mutex() { }
+  };
+
+  constinit rmutex<std::vector<std::string>> registry;
+  constinit rmutex<int, word_mutex>          counter { 41 };
+  constinit rmutex<bounds, spin_mutex>       limits(std::in_place, 1, 3);
+}  // namespace
+
+TEST(constinitTest, GlobalsAreReadyBeforeDynamicInitialization) {
+  ASSERT_TRUE(registered_early);
+  ASSERT_EQ(registry.lock()->size(), 1u);
+  ASSERT_EQ(registry.lock()->front(), "early");
+  ++*counter.lock();
+  ASSERT_EQ(*counter.lock(), 42);
+  ASSERT_EQ(limits.lock()->high, 3);
+  static_assert(!constant_initializable_lockable<dynamic_mutex>);
+}
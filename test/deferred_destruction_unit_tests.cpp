@@ -0,0 +1,152 @@
+// rmutex_lib/test/deferred_destruction_unit_tests.cpp
+
+#include <array>    // For std::array
+#include <map>      // For std::map
+#include <optional> // For std::optional
+#include <thread>   // For std::thread, std::this_thread::get_id
+#include <utility>  // For std::exchange
+#include <vector>   // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/rmutex.hpp"
+#include "rmutexpp/rmutex_backends.hpp"
+#include "rmutexpp/rmutex_guard.hpp"
+
+using namespace rmutexpp;
+
+namespace {
+  // Records, when destroyed, whether its rmutex could be locked (i.e. was already released) and on which thread.
+  template <std::size_t Padding = 0>
+  struct probe {
+      rmutex<int, word_mutex>*     watched;
+      int*                         destroyed_unlocked;
+      std::thread::id*             destroyed_on;
+      std::array<char, Padding + 1> padding {};
+
+      probe(rmutex<int, word_mutex>& mutex, int& counter, std::thread::id& thread):
+          watched(&mutex), destroyed_unlocked(&counter), destroyed_on(&thread) { }
+
+      probe(probe&& other) noexcept:
+          watched(std::exchange(other.watched, nullptr)), destroyed_unlocked(other.destroyed_unlocked), destroyed_on(other.destroyed_on) { }
+
+      ~probe() {
+        if (watched) {
+          *destroyed_unlocked += watched->try_lock().has_value() ? 1 : 0;
+          *destroyed_on = std::this_thread::get_id();
+        }
+      }
+  };
+
+  struct counted {
+      int* destroyed;
+
+      explicit counted(int& counter): destroyed(&counter) { }
+
+      counted(counted&& other) noexcept: destroyed(std::exchange(other.destroyed, nullptr)) { }
+
+      ~counted() {
+        if (destroyed) {
+          ++*destroyed;
+        }
+      }
+  };
+}  // namespace
+
+TEST(deferred_destructionTest, DestroysAfterUnlock) {
+  rmutex<int, word_mutex> mutex { 0 };
+  int                     unlocked = 0;
+  std::thread::id         thread;
+  {
+    auto ref = mutex.lock();
+    for (int i = 0; i < 12; ++i) {  // More than the inline slots: the rest is boxed.
+      ref.defer_after_unlock(probe<>(mutex, unlocked, thread));
+    }
+    ref.defer_after_unlock(probe<256>(mutex, unlocked, thread));  // Too large for a slot.
+    EXPECT_EQ(unlocked, 0);
+  }
+  EXPECT_EQ(unlocked, 13);
+  EXPECT_EQ(thread, std::this_thread::get_id());
+}
+
+TEST(deferred_destructionTest, NestedOwnersFlushSeparately) {
+  rmutex<int, word_mutex> outer { 0 };
+  rmutex<int, word_mutex> inner { 0 };
+  int                     outer_unlocked = 0;
+  int                     inner_unlocked = 0;
+  std::thread::id         thread;
+  {
+    auto outer_ref = outer.lock();
+    outer_ref.defer_after_unlock(probe<>(outer, outer_unlocked, thread));
+    {
+      rmutex_guard guard { inner };
+      guard.defer_after_unlock(probe<>(inner, inner_unlocked, thread));
+    }
+    EXPECT_EQ(inner_unlocked, 1);
+    EXPECT_EQ(outer_unlocked, 0);  // Still waiting for its own rmutex.
+  }
+  EXPECT_EQ(outer_unlocked, 1);
+}
+
+TEST(deferred_destructionTest, RetireHandsOffToReclaimer) {
+  rmutex<int, word_mutex> mutex { 0 };
+  int                     unlocked = 0;
+  std::thread::id         thread;
+  {
+    background_reclaimer reclaimer;
+    {
+      rmutex<std::map<int, std::vector<int>>> index;
+      rmutex_guard                             guard { index, mutex };
+      guard.retire(probe<>(mutex, unlocked, thread), reclaimer);
+    }
+  }  // Joins the reclaimer.
+  EXPECT_EQ(unlocked, 1);
+  EXPECT_NE(thread, std::this_thread::get_id());
+}
+
+TEST(deferred_destructionTest, NonOwningGuardDestroysRightAway) {
+  rmutex<int, word_mutex> mutex { 0 };
+  int                     unlocked = 0;
+  std::thread::id         thread;
+  auto                    ref = mutex.lock();
+  {
+    rmutex_guard guard { std::try_to_lock, mutex };
+    ASSERT_FALSE(guard.owns());
+    guard.defer_after_unlock(probe<>(mutex, unlocked, thread));
+    EXPECT_EQ(thread, std::this_thread::get_id());
+    EXPECT_FALSE(detail::deferred_pending());
+  }
+  EXPECT_EQ(unlocked, 0);  // Destroyed while `ref` held the lock, not queued behind it.
+}
+
+TEST(deferred_destructionTest, NestedRecursiveReleaseWaitsForOutermost) {
+  rmutex<int, recursive_word_mutex> mutex { 0 };
+  int                               destroyed = 0;
+  {
+    auto outer = mutex.lock();
+    outer.defer_after_unlock(counted(destroyed));
+    {
+      auto inner = mutex.lock();
+      inner.defer_after_unlock(counted(destroyed));
+    }
+    EXPECT_EQ(destroyed, 0);  // The lock is still held by `outer`.
+  }
+  EXPECT_EQ(destroyed, 2);
+}
+
+TEST(deferred_destructionTest, ThreadExitDestroysPending) {
+  rmutex<int, word_mutex>                 mutex { 0 };
+  int                                     unlocked = 0;
+  std::thread::id                         thread;
+  std::thread::id                         deferring;
+  std::optional<rmutex_ref<int, word_mutex>> moved;
+  std::thread([&] {
+    deferring = std::this_thread::get_id();
+    auto ref  = mutex.lock();
+    ref.defer_after_unlock(probe<>(mutex, unlocked, thread));
+    moved.emplace(std::move(ref));  // Released on another thread: the entry stays with this one.
+  }).join();
+  EXPECT_EQ(thread, deferring);
+  EXPECT_EQ(unlocked, 0);
+  moved.reset();
+}
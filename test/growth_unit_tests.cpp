@@ -0,0 +1,228 @@
+// rmutex_lib/test/growth_unit_tests.cpp
+
+#include <cstddef>        // For std::size_t
+#include <deque>          // For std::deque
+#include <functional>     // For std::function
+#include <mutex>          // For std::mutex
+#include <stdexcept>      // For std::runtime_error
+#include <string>         // For std::string
+#include <unordered_map>  // For std::unordered_map
+#include <vector>         // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/growth.hpp"
+
+using namespace rmutexpp;
+
+namespace {
+  bool        lock_held            = false;
+  std::size_t allocations_locked   = 0;
+  std::size_t deallocations_locked = 0;
+  std::size_t allocations_unlocked = 0;
+
+  // Records whether the rmutex was held at every lock state change.
+  struct flag_mutex {
+      std::mutex inner;
+
+      void lock() {
+        inner.lock();
+        lock_held = true;
+      }
+
+      bool try_lock() { return inner.try_lock() && (lock_held = true); }
+
+      void unlock() {
+        lock_held = false;
+        inner.unlock();
+      }
+  };
+
+  // Counts allocations and deallocations made while flag_mutex was held.
+  template <typename T>
+  struct tracking_allocator {
+      using value_type = T;
+
+      tracking_allocator() = default;
+
+      template <typename U>
+      tracking_allocator(const tracking_allocator<U>&) noexcept { }
+
+      T* allocate(std::size_t n) {
+        ++(lock_held ? allocations_locked : allocations_unlocked);
+        return std::allocator<T>().allocate(n);
+      }
+
+      void deallocate(T* p, std::size_t n) noexcept {
+        deallocations_locked += lock_held ? 1 : 0;
+        std::allocator<T>().deallocate(p, n);
+      }
+
+      friend bool operator==(const tracking_allocator&, const tracking_allocator&) noexcept { return true; }
+  };
+
+  void reset_counters() { allocations_locked = deallocations_locked = allocations_unlocked = 0; }
+
+  int                   locks_taken = 0;
+  std::function<void()> on_relock;  ///< Runs under the second lock, standing in for another thread.
+
+  struct relock_hook_mutex {
+      std::mutex inner;
+
+      void lock() {
+        inner.lock();
+        if (++locks_taken == 2 && on_relock) {
+          on_relock();
+        }
+      }
+
+      bool try_lock() { return inner.try_lock(); }
+
+      void unlock() { inner.unlock(); }
+  };
+
+  // Copyable, but every move throws: migrating by moves would lose elements halfway.
+  struct throwing_move {
+      int value;
+
+      explicit throwing_move(int v): value(v) { }
+
+      throwing_move(const throwing_move&)            = default;
+      throwing_move& operator=(const throwing_move&) = default;
+
+      throwing_move(throwing_move&&) { throw std::runtime_error("throwing_move moved"); }
+  };
+
+  // Move-only, with a move that may throw: it cannot be staged at all.
+  struct move_only {
+      int value;
+
+      explicit move_only(int v): value(v) { }
+
+      move_only(move_only&& other) noexcept(false): value(other.value) { }
+
+      move_only(const move_only&) = delete;
+  };
+
+  struct throwing_hash {
+      std::size_t operator()(int key) const { return std::hash<int>()(key); }
+  };
+}  // namespace
+
+TEST(growthTest, VectorAllocatesOutsideTheLock) {
+  rmutex<std::vector<std::string, tracking_allocator<std::string>>, flag_mutex> names;
+  (*names.lock()).assign(100, "name");
+  reset_counters();
+  {
+    auto        ref    = lock_for_growth(names, 50);
+    const auto* buffer = ref->data();
+    for (int i = 0; i < 50; ++i) {
+      ref->push_back("more");
+    }
+    EXPECT_EQ(ref->data(), buffer);  // No reallocation while locked.
+    EXPECT_EQ(ref->size(), 150u);
+    EXPECT_EQ((*ref)[0], "name");
+  }
+  EXPECT_EQ(allocations_locked, 0u);
+  EXPECT_EQ(deallocations_locked, 0u);  // The old buffer was freed after the unlock.
+  EXPECT_EQ(allocations_unlocked, 1u);
+}
+
+TEST(growthTest, NoStagingWhenThereIsRoom) {
+  rmutex<std::vector<int>> values;
+  values.lock()->reserve(64);
+  auto ref = lock_for_growth(values, 64);
+  EXPECT_EQ(ref->capacity(), 64u);
+}
+
+// If the container no longer needs to grow once the lock is taken again, the staged
+// storage is dropped instead of migrated into.
+TEST(growthTest, StagingIsDroppedWhenRoomAppearedMeanwhile) {
+  rmutex<std::vector<int>, relock_hook_mutex> values;
+  std::vector<int>*                           raw = &*values.lock();
+  raw->assign(100, 1);
+  raw->shrink_to_fit();
+  const int* buffer = raw->data();
+  locks_taken       = 0;
+  on_relock         = [raw] { raw->clear(); };
+  {
+    auto ref = lock_for_growth(values, 50);
+    EXPECT_TRUE(ref->empty());
+    EXPECT_EQ(ref->data(), buffer);  // Not migrated into the staged buffer.
+    EXPECT_EQ(ref->capacity(), 100u);
+  }
+  on_relock = nullptr;
+}
+
+TEST(growthTest, UnorderedMapRehashesOutsideTheLock) {
+  using map_type = std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, tracking_allocator<std::pair<const int, int>>>;
+  static_assert(detail::fits_deferred_slot<map_type>, "The old table is deferred without boxing.");
+  rmutex<map_type, flag_mutex> counts;
+  for (int key = 0; key < 1000; ++key) {
+    counts.lock()->emplace(key, key);
+  }
+  reset_counters();
+  {
+    auto        ref     = lock_for_growth(counts, 4000);
+    std::size_t buckets = ref->bucket_count();
+    EXPECT_EQ(ref->at(999), 999);
+    EXPECT_EQ(allocations_locked, 0u);  // Nodes were spliced, not copied.
+    for (int key = 1000; key < 5000; ++key) {
+      ref->emplace(key, key);
+    }
+    EXPECT_EQ(ref->bucket_count(), buckets);  // No rehash while locked.
+  }
+  EXPECT_EQ(deallocations_locked, 0u);
+}
+
+TEST(growthTest, DequeJustLocks) {
+  rmutex<std::deque<int>> queue(3, 7);
+  auto                    ref = lock_for_growth(queue, 1000);
+  ref->push_back(1);
+  EXPECT_EQ(ref->size(), 4u);
+  EXPECT_FALSE(queue.try_lock().has_value());
+}
+
+TEST(growthTest, VectorWithThrowingMoveIsCopied) {
+  rmutex<std::vector<throwing_move>> values;
+  {
+    auto ref = values.lock();
+    ref->reserve(8);
+    for (int i = 0; i < 8; ++i) {
+      ref->emplace_back(i);
+    }
+  }
+  auto ref = lock_for_growth(values, 1);
+  EXPECT_GE(ref->capacity(), 9u);
+  ASSERT_EQ(ref->size(), 8u);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ((*ref)[static_cast<std::size_t>(i)].value, i);
+  }
+}
+
+// Without a safe migration, the container is grown under the first lock, never staged.
+TEST(growthTest, UnsafeMigrationGrowsInPlace) {
+  static_assert(!growth_traits<std::vector<move_only>>::can_stage);
+  static_assert(!growth_traits<std::unordered_map<int, int, throwing_hash>>::can_stage);
+  static_assert(growth_traits<std::unordered_map<std::string, int>>::can_stage);
+
+  rmutex<std::vector<move_only>, relock_hook_mutex> values;
+  values.lock()->emplace_back(1);
+  locks_taken = 0;
+  {
+    auto ref = lock_for_growth(values, 100);
+    EXPECT_GE(ref->capacity(), 101u);
+    EXPECT_EQ(ref->front().value, 1);
+  }
+  EXPECT_EQ(locks_taken, 1);
+
+  rmutex<std::unordered_map<int, int, throwing_hash>, relock_hook_mutex> counts;
+  counts.lock()->emplace(1, 1);
+  locks_taken = 0;
+  {
+    auto ref = lock_for_growth(counts, 1000);
+    EXPECT_GE(static_cast<float>(ref->bucket_count()) * ref->max_load_factor(), 1001.0f);
+    EXPECT_EQ(ref->at(1), 1);
+  }
+  EXPECT_EQ(locks_taken, 1);
+}
@@ -0,0 +1,114 @@
+// rmutex_lib/test/hierarchical_rmutex_unit_tests.cpp
+
+#include <atomic>  // For std::atomic
+#include <chrono>  // For std::chrono::milliseconds
+#include <string>  // For std::string
+#include <thread>  // For std::thread
+#include <vector>  // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/hierarchical_rmutex.hpp"
+
+using namespace rmutexpp;
+
+static_assert(lock_modes_compatible(lock_mode::intention_exclusive, lock_mode::intention_exclusive));
+static_assert(!lock_modes_compatible(lock_mode::shared, lock_mode::intention_exclusive));
+static_assert(lock_modes_compatible(lock_mode::intention_shared, lock_mode::shared_intention_exclusive));
+static_assert(combine_lock_modes(lock_mode::shared, lock_mode::intention_exclusive) == lock_mode::shared_intention_exclusive);
+
+// A fixture with one tenant, two tables and one row in each table.
+struct hierarchical_rmutexTest : public ::testing::Test {
+    hierarchical_rmutex<std::string> tenant { "acme" };
+    hierarchical_rmutex<std::string> orders { child_of, tenant, "orders" };
+    hierarchical_rmutex<std::string> users { child_of, tenant, "users" };
+    hierarchical_rmutex<int>         order_row { child_of, orders, 0 };
+    hierarchical_rmutex<int>         user_row { child_of, users, 0 };
+};
+
+TEST_F(hierarchical_rmutexTest, RowWritersInDifferentTablesDoNotConflict) {
+  EXPECT_EQ(order_row.depth(), 2u);
+  auto order = order_row.lock();
+  *order     = 1;
+
+  std::thread other([&] { *user_row.lock() = 2; });  // Would hang if the tables conflicted.
+  other.join();
+  EXPECT_EQ(*user_row.lock_shared(), 2);
+
+  auto orders_intent = orders.lock<lock_mode::intention_shared>();  // IS is compatible with the writer's IX.
+  EXPECT_EQ(*order, 1);
+}
+
+TEST_F(hierarchical_rmutexTest, TableScanWaitsForRowWriter) {
+  std::atomic<bool> scanned { false };
+  std::thread       scanner;
+  {
+    auto order = order_row.lock();
+    scanner    = std::thread([&] {
+      auto scan = orders.lock_shared();
+      EXPECT_EQ(*scan, "orders");
+      scanned = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(scanned.load());  // S on the table conflicts with the writer's IX.
+  }
+  scanner.join();
+  EXPECT_TRUE(scanned.load());
+}
+
+TEST_F(hierarchical_rmutexTest, GuardIsDeadlockFree) {
+  constexpr int            rounds = 5000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (int round = 0; round < rounds; ++round) {
+        if (t % 2 == 0) {
+          hierarchical_guard guard { order_row, user_row };
+          auto [order, user] = guard.get_data();
+          ++order;
+          ++user;
+        } else {
+          hierarchical_guard guard { user_row, orders, order_row };  // Also locks a table and its own row.
+          auto [user, table, order] = guard.get_data();
+          ++order;
+          ++user;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(*order_row.lock_shared(), 4 * rounds);
+  EXPECT_EQ(*user_row.lock_shared(), 4 * rounds);
+}
+
+// Row writers share IX on the tenant and the table while a scanner repeatedly takes S on
+// the table. `rows` stands in for the table's rows: it is only written under a row's X,
+// so every scan must see it between two writes, never in the middle of one.
+TEST_F(hierarchical_rmutexTest, ScansInterleaveWithIntentionWriters) {
+  constexpr int            rounds = 5000;
+  int                      rows   = 0;
+  bool                     torn   = false;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 3; ++t) {
+    threads.emplace_back([&] {
+      for (int round = 0; round < rounds; ++round) {
+        auto row = order_row.lock();
+        ++rows;
+        ++rows;  // Odd values only exist under a row's X.
+      }
+    });
+  }
+  threads.emplace_back([&] {
+    for (int round = 0; round < rounds; ++round) {
+      auto table = orders.lock_shared();
+      torn       = torn || rows % 2 != 0;
+    }
+  });
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_FALSE(torn);
+  EXPECT_EQ(rows, 3 * 2 * rounds);
+}
@@ -0,0 +1,86 @@
+// rmutex_lib/test/intrusive_rmutex_unit_tests.cpp
+
+#include <cstdint>  // For std::uint32_t, std::uint64_t
+#include <thread>   // For std::thread
+#include <vector>   // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/rmutex.hpp"
+#include "rmutexpp/rmutex_backends.hpp"
+#include "rmutexpp/rmutex_guard.hpp"
+
+using namespace rmutexpp;
+
+namespace {
+  struct order {
+      std::uint64_t id;
+      std::uint32_t quantity;
+      word_mutex    rmutex_lock;  // Takes the 4 bytes of padding after `quantity`.
+
+      order(std::uint64_t i, std::uint32_t q) noexcept: id(i), quantity(q) { }
+  };
+
+  struct order_without_lock {
+      std::uint64_t id;
+      std::uint32_t quantity;
+  };
+
+  struct flags {
+      std::uint16_t bits;
+      spin_mutex    guard;
+
+      explicit flags(std::uint16_t b) noexcept: bits(b) { }
+  };
+}  // namespace
+
+template <>
+struct rmutexpp::intrusive_lock_traits<flags> {
+    static constexpr auto member = &flags::guard;
+};
+
+static_assert(sizeof(order) == sizeof(order_without_lock));
+static_assert(sizeof(intrusive_rmutex<order>) == sizeof(order));
+static_assert(sizeof(intrusive_rmutex<flags>) == sizeof(flags));
+
+TEST(intrusive_rmutexTest, LocksThroughTheMemberLock) {
+  intrusive_rmutex<order> pending(std::in_place, 7u, 3u);
+  {
+    rmutex_ref data = pending.lock();
+    ASSERT_EQ(data->id, 7u);
+    ASSERT_FALSE(pending.try_lock().has_value());
+    data->quantity = 5;
+  }
+  ASSERT_EQ(pending.with_lock([](order& o) { return o.quantity; }), 5u);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 1000; ++i) {
+        ++pending.lock()->quantity;
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(pending.lock()->quantity, 4005u);
+}
+
+TEST(intrusive_rmutexTest, GuardsAndTraitSelectedMembers) {
+  intrusive_rmutex<order> from(std::in_place, 1u, 10u);
+  intrusive_rmutex<order> to(std::in_place, 2u, 0u);
+  intrusive_rmutex<flags> marks(std::in_place, std::uint16_t { 0 });
+  {
+    rmutex_guard all(from, to, marks);
+    ASSERT_TRUE(all.owns());
+    auto [source, target, bits] = *all.get_data();
+    source.quantity -= 4;
+    target.quantity += 4;
+    bits.bits |= 1;
+  }
+  with_locks([](order& a, order& b) { std::swap(a.quantity, b.quantity); }, from, to);
+  ASSERT_EQ(from.lock()->quantity, 4u);
+  ASSERT_EQ(to.lock()->quantity, 6u);
+  ASSERT_EQ(marks.lock()->bits, 1);
+}
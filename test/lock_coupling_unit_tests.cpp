@@ -0,0 +1,130 @@
+// rmutex_lib/test/lock_coupling_unit_tests.cpp
+
+#include <iterator>  // For std::input_iterator
+#include <memory>    // For std::unique_ptr
+#include <thread>    // For std::thread
+#include <vector>    // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/lock_coupling.hpp"
+
+using namespace rmutexpp;
+
+namespace {
+  struct list_node {
+      int                                value = 0;
+      std::unique_ptr<rmutex<list_node>> next;
+  };
+
+  rmutex<list_node>* next_node(list_node& node) { return node.next.get(); }
+
+  // Appends nodes holding 1, 2, ..., count after `head`.
+  void build_list(rmutex<list_node>& head, int count) {
+    std::unique_ptr<rmutex<list_node>>* tail = &head.lock()->next;
+    for (int value = 1; value <= count; ++value) {
+      *tail = std::make_unique<rmutex<list_node>>(list_node { value, nullptr });
+      tail  = &(*tail)->lock()->next;
+    }
+  }
+}  // namespace
+
+// The iterator holds exactly the current node and its predecessor.
+TEST(lock_couplingTest, HoldsTwoNodeWindow) {
+  rmutex<list_node> head;
+  build_list(head, 3);
+  rmutex<list_node>& first  = *head.lock()->next;
+  rmutex<list_node>& second = *first.lock()->next;
+
+  auto it = lock_coupled(head, &next_node).begin();
+  static_assert(std::input_iterator<decltype(it)>);
+  EXPECT_EQ(it.previous(), nullptr);
+  EXPECT_FALSE(head.try_lock().has_value());
+  EXPECT_TRUE(first.try_lock().has_value());
+
+  ++it;
+  EXPECT_EQ(it->value, 1);
+  EXPECT_EQ(it.previous()->value, 0);
+  EXPECT_FALSE(head.try_lock().has_value());
+  EXPECT_FALSE(first.try_lock().has_value());
+  EXPECT_TRUE(second.try_lock().has_value());
+
+  ++it;
+  EXPECT_EQ(it->value, 2);
+  EXPECT_TRUE(head.try_lock().has_value());  // Released once the window moved past it.
+
+  ++it;
+  ++it;
+  EXPECT_TRUE(it == std::default_sentinel);
+  EXPECT_TRUE(second.try_lock().has_value());
+}
+
+// Erasing releases the erased node's lock before destroying it and moves onto its successor.
+TEST(lock_couplingTest, EraseCurrentUnlinksAndMovesOn) {
+  rmutex<list_node> head;
+  build_list(head, 4);
+
+  auto unlink = [](list_node& previous) {
+    std::unique_ptr<rmutex<list_node>> erased = std::move(previous.next);
+    previous.next                             = std::move(erased->lock()->next);
+    return erased;
+  };
+  auto it = lock_coupled(head, &next_node).begin();
+  ++it;
+  ++it;
+  ASSERT_EQ(it->value, 2);
+  it.erase_current(unlink);
+  EXPECT_EQ(it->value, 3);
+  EXPECT_EQ(it.previous()->value, 1);
+  ++it;
+  it.erase_current(unlink);  // The last node: the walk ends.
+  EXPECT_TRUE(it == std::default_sentinel);
+
+  std::vector<int> remaining;
+  for (list_node& node : lock_coupled(head, &next_node)) {
+    remaining.push_back(node.value);
+  }
+  EXPECT_EQ(remaining, (std::vector<int> { 0, 1, 3 }));
+}
+
+// Readers that increment every node pipeline behind writers that insert new nodes.
+TEST(lock_couplingTest, ConcurrentTraversalsAndInserts) {
+  constexpr int     nodes  = 50;
+  constexpr int     rounds = 500;
+  rmutex<list_node> head;
+  build_list(head, nodes);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 3; ++t) {
+    threads.emplace_back([&head] {
+      for (int round = 0; round < rounds; ++round) {
+        for (list_node& node : lock_coupled(head, &next_node)) {
+          node.value += 1000;
+        }
+      }
+    });
+  }
+  threads.emplace_back([&head] {
+    for (int round = 0; round < rounds; ++round) {
+      int position = 0;
+      for (auto it = lock_coupled(head, &next_node).begin(); it != std::default_sentinel; ++it) {
+        if (++position == nodes / 2) {
+          it->next = std::make_unique<rmutex<list_node>>(list_node { -1, std::move(it->next) });
+          break;
+        }
+      }
+    }
+  });
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  int count = 0;
+  for (list_node& node : lock_coupled(head, &next_node)) {
+    ++count;
+    if ((node.value + 1) % 1000 != 0) {  // Inserted nodes start at -1 and may have missed earlier walks.
+      EXPECT_EQ(node.value / 1000, 3 * rounds) << "node " << node.value % 1000 << " missed an increment";
+    }
+  }
+  EXPECT_EQ(count, 1 + nodes + rounds);
+}
@@ -0,0 +1,91 @@
+// rmutex_lib/test/olc_btree_unit_tests.cpp
+
+#include <cstdint>  // For std::uint64_t
+#include <thread>   // For std::thread
+#include <vector>   // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/olc_btree.hpp"
+#include "rmutexpp/optimistic_lock.hpp"
+#include "rmutexpp/rmutex.hpp"
+
+using namespace rmutexpp;
+
+// Reads validate until a write section ends; upgrades fail once the version moved on.
+TEST(optimistic_lockTest, ValidateAndUpgrade) {
+  optimistic_lock lock;
+  auto            version = lock.read_begin();
+  ASSERT_TRUE(version.has_value());
+  EXPECT_TRUE(lock.validate(*version));
+
+  ASSERT_TRUE(lock.try_upgrade(*version));
+  EXPECT_FALSE(lock.read_begin().has_value());
+  EXPECT_FALSE(lock.try_lock());
+  lock.unlock();
+
+  EXPECT_FALSE(lock.validate(*version));
+  EXPECT_FALSE(lock.try_upgrade(*version));
+  auto next = lock.read_begin();
+  ASSERT_TRUE(next.has_value());
+  EXPECT_NE(*next, *version);
+
+  lock.lock();
+  lock.unlock_obsolete();
+  EXPECT_FALSE(lock.read_begin_wait().has_value());
+
+  static_assert(rmutex_lockable<optimistic_lock>);
+}
+
+// An obsolete object can never be unlocked again, so lock() must fail loudly instead of spinning.
+TEST(optimistic_lockTest, LockingAnObsoleteObjectTerminates) {
+  GTEST_FLAG_SET(death_test_style, "threadsafe");
+  optimistic_lock lock;
+  lock.lock();
+  lock.unlock_obsolete();
+  EXPECT_FALSE(lock.try_lock());
+  EXPECT_DEATH(lock.lock(), "");
+}
+
+TEST(olc_btreeTest, InsertFindAndOverwrite) {
+  olc_btree<std::uint64_t, std::uint64_t, 8> tree;  // Small nodes force several levels of splits.
+  for (std::uint64_t key = 0; key < 5000; ++key) {
+    EXPECT_TRUE(tree.insert_or_assign((key * 7919) % 5000, key));
+  }
+  EXPECT_FALSE(tree.insert_or_assign(17, 1234));
+  EXPECT_EQ(tree.find(17), 1234u);
+  for (std::uint64_t key = 0; key < 5000; ++key) {
+    ASSERT_TRUE(tree.contains(key)) << "missing key " << key;
+  }
+  EXPECT_FALSE(tree.find(5000).has_value());
+}
+
+// Writers insert disjoint key sets while readers look keys up; afterwards every key is present.
+TEST(olc_btreeTest, ConcurrentInsertsAndLookups) {
+  constexpr unsigned      writers          = 3;
+  constexpr std::uint64_t keys_per_writer = 20000;
+  olc_btree<std::uint64_t, std::uint64_t, 16> tree;
+
+  std::vector<std::thread> threads;
+  for (unsigned w = 0; w < writers; ++w) {
+    threads.emplace_back([&tree, w] {
+      for (std::uint64_t i = 0; i < keys_per_writer; ++i) {
+        std::uint64_t key = i * writers + w;
+        tree.insert_or_assign(key, key + 1);
+      }
+    });
+  }
+  threads.emplace_back([&tree] {
+    for (std::uint64_t i = 0; i < keys_per_writer; ++i) {
+      if (auto value = tree.find(i)) {
+        EXPECT_EQ(*value, i + 1);
+      }
+    }
+  });
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (std::uint64_t key = 0; key < writers * keys_per_writer; ++key) {
+    ASSERT_EQ(tree.find(key), key + 1) << "at key " << key;
+  }
+}
@@ -0,0 +1,92 @@
+// rmutex_lib/test/once_cell_unit_tests.cpp
+
+#include <atomic>     // For std::atomic
+#include <chrono>     // For std::chrono::milliseconds
+#include <stdexcept>  // For std::runtime_error
+#include <string>     // For std::string
+#include <thread>     // For std::thread, std::this_thread::sleep_for
+#include <vector>     // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/once_cell.hpp"
+#include "rmutexpp/rmutex.hpp"
+
+using namespace rmutexpp;
+
+TEST(once_cellTest, InitializesOnceAcrossThreads) {
+  once_cell<std::string> cell;
+  std::atomic<int>       calls { 0 };
+  ASSERT_EQ(cell.get(), nullptr);
+
+  std::vector<std::thread>  threads;
+  std::vector<std::string*> seen(8);
+  for (std::size_t t = 0; t < seen.size(); ++t) {
+    threads.emplace_back([&, t] {
+      seen[t] = &cell.get_or_init([&] {
+        ++calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));  // Makes the others park.
+        return std::string("built");
+      });
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(calls, 1);
+  for (std::string* value : seen) {
+    ASSERT_EQ(value, cell.get());
+  }
+  ASSERT_EQ(*cell.get(), "built");
+}
+
+TEST(once_cellTest, FailedInitializationIsRetried) {
+  once_cell<int> cell;
+  ASSERT_THROW(cell.get_or_init([]() -> int { throw std::runtime_error("unavailable"); }), std::runtime_error);
+  ASSERT_EQ(cell.get(), nullptr);
+  ASSERT_EQ(cell.get_or_init([] { return 7; }), 7);
+  ASSERT_EQ(cell.get_or_init([] { return 8; }), 7);
+}
+
+TEST(once_cellTest, ParkedThreadsRetryAfterAFailure) {
+  once_cell<int>   cell;
+  std::atomic<int> attempts { 0 };
+  std::atomic<int> failures { 0 };
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      try {
+        cell.get_or_init([&] {
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          if (attempts++ == 0) {
+            throw std::runtime_error("first attempt fails");
+          }
+          return 42;
+        });
+      } catch (const std::runtime_error&) {
+        ++failures;
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(failures, 1);
+  ASSERT_EQ(attempts, 2);
+  ASSERT_EQ(*cell.get(), 42);
+}
+
+TEST(once_cellTest, LazyValueWithMutableContents) {
+  int   builds = 0;
+  rlazy counters([&] {
+    ++builds;
+    return rmutex<std::vector<int>>(std::in_place, 3, 0);
+  });
+  ASSERT_FALSE(counters.initialized());
+  ++counters->lock()->at(1);
+  ++(*counters).lock()->at(1);
+  ASSERT_TRUE(counters.initialized());
+  ASSERT_EQ(builds, 1);
+  ASSERT_EQ(counters->lock()->at(1), 2);
+}
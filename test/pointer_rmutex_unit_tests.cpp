@@ -0,0 +1,89 @@
+// rmutex_lib/test/pointer_rmutex_unit_tests.cpp
+
+#include <memory>  // For std::unique_ptr, std::make_unique
+#include <thread>  // For std::thread
+#include <vector>  // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/pointer_rmutex.hpp"
+
+using namespace rmutexpp;
+
+namespace {
+  struct node {
+      int   value;
+      node* next = nullptr;
+  };
+
+  struct tracked {
+      static inline int live = 0;
+
+      int value;
+
+      explicit tracked(int v): value(v) { ++live; }
+      ~tracked() { --live; }
+  };
+}  // namespace
+
+static_assert(sizeof(pointer_rmutex<node*>) == sizeof(node*));
+static_assert(sizeof(pointer_rmutex<std::unique_ptr<node>>) == sizeof(node*));
+
+TEST(pointer_rmutexTest, LockSetAndGet) {
+  node                  first { 1 };
+  node                  second { 2 };
+  pointer_rmutex<node*> slot(&first);
+  {
+    auto head = slot.lock();
+    ASSERT_EQ(head.get(), &first);
+    ASSERT_EQ(head->value, 1);
+    ASSERT_FALSE(slot.try_lock().has_value());
+    head.set(&second);
+  }
+  auto again = slot.try_lock();
+  ASSERT_TRUE(again.has_value());
+  ASSERT_EQ((*again)->value, 2);
+}
+
+TEST(pointer_rmutexTest, ContendedBucketsStayConsistent) {
+  // Few buckets and many threads, so that waiters park on the parking table.
+  std::vector<pointer_rmutex<node*>> buckets(4);
+  std::vector<std::thread>           threads;
+  std::vector<std::vector<node>>     pools(8, std::vector<node>(2000));
+  for (std::size_t t = 0; t < pools.size(); ++t) {
+    threads.emplace_back([&, t] {
+      for (std::size_t i = 0; i < pools[t].size(); ++i) {
+        node* fresh = &pools[t][i];
+        auto  head  = buckets[i % buckets.size()].lock();
+        fresh->next = head.get();
+        head.set(fresh);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  std::size_t total = 0;
+  for (pointer_rmutex<node*>& bucket : buckets) {
+    for (node* at = bucket.lock().get(); at; at = at->next) {
+      ++total;
+    }
+  }
+  ASSERT_EQ(total, 8u * 2000u);
+}
+
+TEST(pointer_rmutexTest, UniquePtrIsOwned) {
+  {
+    pointer_rmutex<std::unique_ptr<tracked>> owner(std::make_unique<tracked>(1));
+    ASSERT_EQ(tracked::live, 1);
+    std::unique_ptr<tracked> previous = owner.lock().exchange(std::make_unique<tracked>(2));
+    ASSERT_EQ(previous->value, 1);
+    previous.reset();
+    ASSERT_EQ(tracked::live, 1);
+
+    pointer_rmutex<std::unique_ptr<tracked>> moved(std::move(owner));
+    ASSERT_EQ(owner.lock().get(), nullptr);
+    ASSERT_EQ(moved.lock()->value, 2);
+  }
+  ASSERT_EQ(tracked::live, 0);
+}
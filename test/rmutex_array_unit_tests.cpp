@@ -0,0 +1,58 @@
+// rmutex_lib/test/rmutex_array_unit_tests.cpp
+
+#include <cstdint>  // For std::uint64_t
+#include <mutex>    // For std::mutex
+#include <numeric>  // For std::accumulate
+#include <thread>   // For std::thread
+#include <vector>   // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/rmutex_array.hpp"
+
+using namespace rmutexpp;
+
+TEST(rmutex_arrayTest, ElementsLockIndependently) {
+  rmutex_array<std::uint64_t> counters(64);
+  ASSERT_EQ(counters.size(), 64u);
+  {
+    auto first = counters.lock(0);
+    ASSERT_FALSE(counters.try_lock(0).has_value());
+    auto second = counters.try_lock(1);
+    ASSERT_TRUE(second.has_value());
+    **second = 5;
+    *first   = 3;
+  }
+  ASSERT_EQ(counters.with_lock(0, [](std::uint64_t& v) { return v; }), 3u);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (std::size_t i = 0; i < 64 * 100; ++i) {
+        ++*counters.lock(i % 64);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  auto all = counters.lock_all();
+  ASSERT_EQ(std::accumulate(all.span().begin(), all.span().end(), std::uint64_t { 0 }), 3u + 5u + 4u * 64u * 100u);
+}
+
+TEST(rmutex_arrayTest, TryForEachSkipsHeldElements) {
+  rmutex_array<int, word_mutex, lock_layout::padded> slots(8, 1);
+  static_assert(alignof(detail::lock_slot<word_mutex, lock_layout::padded>) == 64);
+  auto        held    = slots.lock(3);
+  int         sum     = 0;
+  std::size_t visited = slots.try_for_each([&](std::size_t index, int& value) {
+    EXPECT_NE(index, 3u);
+    sum += value;
+  });
+  ASSERT_EQ(visited, 7u);
+  ASSERT_EQ(sum, 7);
+
+  rmutex_array<int, std::mutex> standard(2);
+  *standard.lock(1) = 4;
+  ASSERT_EQ((*standard.lock_all())[1], 4);
+}
@@ -1,17 +1,22 @@
 // rmutex_lib/test/rmutex_unit_tests.cpp
 
 // Standard library headers for various functionalities
-#include <chrono>    // For std::chrono::milliseconds and std::this_thread::sleep_for
-#include <optional>  // For std::optional, used by try_lock results
-#include <string>    // For std::string
-#include <thread>    // For std::thread, used in concurrency tests
-#include <vector>    // For std::vector (though not directly used in the current tests, often useful)
+#include <chrono>     // For std::chrono::milliseconds and std::this_thread::sleep_for
+#include <memory>     // For std::unique_ptr, std::make_unique
+#include <optional>   // For std::optional, used by try_lock results
+#include <stdexcept>  // For std::runtime_error
+#include <string>     // For std::string
+#include <thread>     // For std::thread, used in concurrency tests
+#include <utility>    // For std::as_const
+#include <tuple>      // For std::forward_as_tuple
+#include <vector>     // For std::vector (though not directly used in the current tests, often useful)
 
 // Google Test framework header
 #include "gtest/gtest.h"
 
 // Headers for the rmutexpp library components being tested
 #include "rmutexpp/rmutex.hpp"
+#include "rmutexpp/rmutex_backends.hpp"
 #include "rmutexpp/rmutex_guard.hpp"
 
 // Use the rmutexpp namespace for convenience within this test file.
@@ -79,6 +84,44 @@ TEST_F(rmutexTest, rmutex_refTryLock) {
   ASSERT_EQ(*(*optional_ref), "initial");
 }
 
+// This test verifies that move-assigning an rmutex_ref releases its lock and rebinds it
+// to the other rmutex, instead of copying the other rmutex's data into its own.
+TEST_F(rmutexTest, rmutex_refMoveAssignment) {
+  rmutex<int>     other { 7 };
+  rmutex_ref<int> ref = int_mutex.lock();
+  *ref                = 5;
+  ref                 = other.lock();
+  ASSERT_EQ(*ref, 7);
+  ASSERT_TRUE(int_mutex.try_lock());  // Released by the assignment.
+  *ref = 8;
+  ref  = int_mutex.try_lock().value();
+  ASSERT_EQ(*ref, 5);
+  ASSERT_EQ(*other.try_lock().value(), 8);
+}
+
+// This test verifies that a non-const rmutex_ref converts to bool through its ownership,
+// not through the implicit conversion to the protected value.
+TEST_F(rmutexTest, rmutex_refBoolConversion) {
+  rmutex_ref<int> ref = int_mutex.lock();
+  ASSERT_EQ(*ref, 0);
+  ASSERT_TRUE(ref);
+  ASSERT_TRUE(static_cast<bool>(ref));
+}
+
+// This test verifies data access through an rmutex_guard of a single rmutex.
+TEST_F(rmutexTest, rmutex_guardSingleGetData) {
+  {
+    rmutex_guard guard { test_mutex };
+    ASSERT_TRUE(guard.owns());
+    guard.get_data()->get() += "_guarded";
+    ASSERT_EQ(std::as_const(guard).get_data()->get(), "initial_guarded");
+  }
+  rmutex_guard held { test_mutex };
+  rmutex_guard failed { std::try_to_lock, test_mutex };
+  ASSERT_FALSE(failed.owns());
+  ASSERT_FALSE(failed.get_data());
+}
+
 // This test verifies rmutex_guard's ability to acquire and manage locks on multiple mutexes.
 TEST_F(rmutexTest, rmutex_guardMultiLock) {
   // Create two separate rmutex instances with different data types.
@@ -162,6 +205,264 @@ TEST_F(rmutexTest, rmutex_guardDeadlockPrevention) {
   ASSERT_TRUE((final_m1_val == 10 && final_m2_val == 20) || (final_m1_val == 100 && final_m2_val == 200));
 }
 
+// Hammers one counter from several threads through rmutex<int, Mutex>; any lost update
+// means the backend failed to provide mutual exclusion.
+template <typename Mutex>
+static void expectMutualExclusion() {
+  rmutex<int, Mutex>       counter { 0 };
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 20000; ++i) {
+        rmutex_ref ref = counter.lock();
+        ++*ref;
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(*counter.lock(), 4 * 20000);
+}
+
+// This test verifies that the alternative lock backends keep rmutex's guarantees.
+TEST_F(rmutexTest, rmutexBackendsMutualExclusion) {
+  static_assert(std::is_same_v<rmutex_mutex_type_t<rmutex<int>>, std::mutex>);
+  static_assert(std::is_same_v<rmutex_mutex_type_t<rmutex<int, word_mutex>>, word_mutex>);
+  static_assert(sizeof(word_mutex) == 4 && sizeof(spin_mutex) == 1);
+  expectMutualExclusion<spin_mutex>();
+  expectMutualExclusion<word_mutex>();
+}
+
+// This test verifies try_lock and rmutex_guard on rmutex objects with non-default backends.
+TEST_F(rmutexTest, rmutexBackendsTryLockAndGuard) {
+  rmutex<std::string, word_mutex> text { "word" };
+  rmutex<int, spin_mutex>         number { 1 };
+  {
+    rmutex_ref ref = text.lock();
+    ASSERT_FALSE(text.try_lock());
+  }
+  ASSERT_TRUE(text.try_lock());
+  {
+    rmutex_guard guard { text, number };
+    ASSERT_TRUE(guard.owns());
+    auto [s, n] = *guard.get_data();
+    s += "_mutex";
+    ++n;
+  }
+  {
+    rmutex_guard single { std::try_to_lock, number };
+    ASSERT_TRUE(single.owns());
+  }
+  ASSERT_EQ(*number.lock(), 2);
+  ASSERT_EQ(*text.lock(), "word_mutex");
+}
+
+// This test verifies the whole-value operations: replace(), take() and swap().
+TEST_F(rmutexTest, rmutexReplaceTakeSwap) {
+  rmutex<std::vector<int>> values { std::vector<int> { 1, 2, 3 } };
+  std::vector<int>         rebuilt { 4, 5 };
+  const int*               buffer = rebuilt.data();
+
+  std::vector<int> old = values.replace(std::move(rebuilt));
+  ASSERT_EQ(old, (std::vector<int> { 1, 2, 3 }));
+  ASSERT_EQ(values.lock()->data(), buffer);  // The buffer moved in, nothing was copied.
+  ASSERT_TRUE(values.try_lock());            // Released before returning.
+
+  std::vector<int> other { 6 };
+  values.swap(other);
+  ASSERT_EQ(other, (std::vector<int> { 4, 5 }));
+
+  std::vector<int> taken = values.take();
+  ASSERT_EQ(taken, (std::vector<int> { 6 }));
+  ASSERT_TRUE(values.lock()->empty());
+
+  ASSERT_EQ(test_mutex.replace("replaced"), "initial");
+  ASSERT_EQ(*test_mutex.lock(), "replaced");
+}
+
+// This test verifies the lambda critical sections: with_lock() and with_locks().
+TEST_F(rmutexTest, rmutexWithLock) {
+  std::size_t length = test_mutex.with_lock([](std::string& text) {
+    text += "_suffix";
+    return text.size();
+  });
+  ASSERT_EQ(length, std::string("initial_suffix").size());
+  ASSERT_TRUE(test_mutex.try_lock());  // Released on return.
+
+  // Move-only results are forwarded, and the lock is released if fn throws.
+  std::unique_ptr<int> boxed = int_mutex.with_lock([](int& value) { return std::make_unique<int>(++value); });
+  ASSERT_EQ(*boxed, 1);
+  ASSERT_THROW(int_mutex.with_lock([](int&) { throw std::runtime_error("inside"); }), std::runtime_error);
+  ASSERT_TRUE(int_mutex.try_lock());
+
+  // Opposite lock orders on two threads must not deadlock.
+  std::thread forward([&] {
+    for (int i = 0; i < 1000; ++i) {
+      with_locks([](std::string&, int& value) { ++value; }, test_mutex, int_mutex);
+    }
+  });
+  for (int i = 0; i < 1000; ++i) {
+    with_locks([](int& value, std::string&) { ++value; }, int_mutex, test_mutex);
+  }
+  forward.join();
+  ASSERT_EQ(with_locks([](int& value) { return value; }, int_mutex), 2001);
+}
+
+// This test verifies the pointer-only layouts of rmutex_ref and rmutex_guard.
+TEST_F(rmutexTest, rmutexSlimLayouts) {
+  static_assert(sizeof(rmutex_ref<std::string>) == sizeof(void*));
+  static_assert(sizeof(rmutex_guard<rmutex<int>>) == sizeof(void*));
+  static_assert(sizeof(rmutex_guard<rmutex<int>, rmutex<std::string>, rmutex<char, spin_mutex>>) == 3 * sizeof(void*));
+  static_assert(alignof(rmutex<char, spin_mutex>) >= 2);
+
+  // Move assignment releases the lock held by the target and leaves the source empty.
+  // Every lock is taken in one order (test_mutex, other, int_mutex), so no inversion.
+  rmutex<int> other { 7 };
+  {
+    rmutex_ref<std::string> text   = test_mutex.lock();
+    rmutex_ref<int>         source = other.lock();
+    rmutex_ref<int>         number = int_mutex.lock();
+    rmutex_ref<int>         moved  = std::move(number);
+    ASSERT_FALSE(number);
+    *moved = 5;
+    moved  = std::move(source);
+    ASSERT_FALSE(source);
+    ASSERT_TRUE(int_mutex.try_lock());  // Released by the assignment.
+    ASSERT_EQ(*moved, 7);
+    ASSERT_EQ(*int_mutex.lock(), 5);
+    ASSERT_EQ(*text, "initial");  // Untouched by the data of other references.
+  }
+
+  // Ownership travels with the guard, and the single-rmutex guard's data is reachable.
+  rmutex_guard guard { std::try_to_lock, test_mutex };
+  ASSERT_TRUE(guard.owns());
+  guard.get_data()->get() += "_guarded";
+  rmutex_guard taken = std::move(guard);
+  ASSERT_FALSE(guard.owns());
+  ASSERT_TRUE(taken.owns());
+  ASSERT_EQ(std::as_const(taken).get_data()->get(), "initial_guarded");
+}
+
+// This test verifies in-place construction and the single move-construction of the data.
+TEST_F(rmutexTest, rmutexInPlaceConstruction) {
+  struct pinned {  // Neither default-constructible nor movable.
+      std::string name;
+      int         weight;
+
+      pinned(std::string n, int w): name(std::move(n)), weight(w) { }
+      pinned(pinned&&) = delete;
+  };
+  rmutex<pinned> in_place(std::in_place, "pinned", 3);
+  rmutex<pinned> piecewise(std::piecewise_construct, std::forward_as_tuple("piece", 4));
+  ASSERT_EQ(in_place.lock()->name, "pinned");
+  ASSERT_EQ(piecewise.lock()->weight, 4);
+
+  struct counted {  // Not default-constructible; counts its moves.
+      int moves = 0;
+
+      explicit counted(int) { }
+      counted(counted&& other) noexcept: moves(other.moves + 1) { }
+      counted& operator=(counted&&) = delete;
+  };
+  rmutex<counted> source(std::in_place, 0);
+  rmutex<counted> moved(std::move(source));
+  ASSERT_EQ(moved.lock()->moves, 1);
+  static_assert(std::is_nothrow_move_constructible_v<rmutex<counted>>);
+  static_assert(!std::is_constructible_v<rmutex<std::string>, rmutex<std::string>&>);
+
+  // Growing a vector of rmutex relocates every element by one move.
+  std::vector<rmutex<std::string>> shards;
+  for (int i = 0; i < 100; ++i) {
+    shards.emplace_back(std::in_place, 20, static_cast<char>('a' + i % 26));
+  }
+  ASSERT_EQ(*shards[27].lock(), std::string(20, 'b'));
+}
+
+// This test verifies that a frozen rmutex is read without locking and can no longer be locked.
+TEST_F(rmutexTest, rmutexFreezeAndRead) {
+  rmutex<std::vector<int>, freezable_mutex<>> table;
+  {
+    std::vector<std::thread> builders;
+    for (int t = 0; t < 4; ++t) {
+      builders.emplace_back([&] {
+        for (int i = 0; i < 100; ++i) {
+          table.lock()->push_back(i);
+        }
+      });
+    }
+    for (std::thread& builder : builders) {
+      builder.join();
+    }
+  }
+  ASSERT_FALSE(table.frozen());
+  table.freeze();
+  ASSERT_TRUE(table.frozen());
+  ASSERT_FALSE(table.try_lock().has_value());
+
+  std::vector<std::thread> readers;
+  std::vector<std::size_t> sizes(4);
+  for (std::size_t t = 0; t < sizes.size(); ++t) {
+    readers.emplace_back([&, t] { sizes[t] = table.read().size(); });
+  }
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  for (std::size_t size : sizes) {
+    ASSERT_EQ(size, 400u);
+  }
+  static_assert(!freezable_lockable<std::mutex>);
+  static_assert(constant_initializable_lockable<freezable_mutex<spin_mutex>>);
+}
+
+// This test verifies that locking a frozen rmutex fails in every build mode, not only under assertions.
+TEST_F(rmutexTest, rmutexLockAfterFreezeTerminates) {
+  GTEST_FLAG_SET(death_test_style, "threadsafe");
+  rmutex<int, freezable_mutex<>> value { 1 };
+  value.freeze();
+  EXPECT_DEATH(value.lock(), "");
+  EXPECT_DEATH((void)value.with_lock([](int& v) { return v; }), "");
+  EXPECT_EQ(value.read(), 1);
+}
+
+// This test verifies nested locking through the reentrant backend, on one thread and across threads.
+TEST_F(rmutexTest, rmutexRecursiveBackend) {
+  rmutex<int, recursive_word_mutex> counter { 0 };
+  rmutex<int, recursive_word_mutex> other { 0 };
+  {
+    rmutex_ref outer = counter.lock();
+    rmutex_ref inner = counter.lock();  // Re-entered by the owner.
+    ++*inner;
+    auto again = counter.try_lock();
+    ASSERT_TRUE(again.has_value());
+    ++**again;
+
+    rmutex_guard both(counter, other);  // One of the two is already held.
+    ASSERT_TRUE(both.owns());
+    ++*outer;
+
+    bool locked_elsewhere = true;
+    std::thread([&] { locked_elsewhere = counter.try_lock().has_value(); }).join();
+    ASSERT_FALSE(locked_elsewhere);
+  }
+  ASSERT_EQ(*counter.lock(), 3);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 1000; ++i) {
+        rmutex_ref outer = counter.lock();
+        ++*counter.lock();
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(*counter.lock(), 4003);
+  static_assert(sizeof(recursive_word_mutex) < sizeof(std::recursive_mutex));
+}
+
 // Additional test cases can be added below this line.
 // Examples include:
 // - Testing const access to guarded data.
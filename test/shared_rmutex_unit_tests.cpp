@@ -0,0 +1,86 @@
+// rmutex_lib/test/shared_rmutex_unit_tests.cpp
+
+#include <string>  // For std::string
+#include <thread>  // For std::thread
+#include <vector>  // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/rmutex_backends.hpp"
+#include "rmutexpp/shared_rmutex.hpp"
+
+using namespace rmutexpp;
+
+namespace {
+  // Counts live instances, to check when the shared data is destroyed.
+  struct tracked {
+      static inline int live = 0;
+
+      int value;
+
+      explicit tracked(int v): value(v) { ++live; }
+      tracked(tracked&& other) noexcept: value(other.value) { ++live; }
+      ~tracked() { --live; }
+  };
+}  // namespace
+
+TEST(shared_rmutexTest, SharesOneRmutexAcrossHandles) {
+  shared_rmutex<std::vector<int>> counters = make_shared_rmutex<std::vector<int>>(4, 0);
+  ASSERT_EQ(counters.use_count(), 1u);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([counters, t] {
+      for (int i = 0; i < 1000; ++i) {
+        ++counters.lock()->at(t);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(counters.use_count(), 1u);
+  ASSERT_EQ(counters.with_lock([](const std::vector<int>& v) { return v[0] + v[1] + v[2] + v[3]; }), 4000);
+  auto taken = counters->take();
+  ASSERT_EQ(taken.size(), 4u);
+}
+
+TEST(shared_rmutexTest, LastStrongHandleDestroysTheData) {
+  auto first  = make_shared_rmutex<tracked, word_mutex>(7);
+  auto second = first;
+  ASSERT_EQ(second.use_count(), 2u);
+  ASSERT_TRUE(first == second);
+  weak_rmutex<tracked, word_mutex> weak(first);
+
+  first.reset();
+  ASSERT_FALSE(first);
+  ASSERT_EQ(tracked::live, 1);
+  {
+    shared_rmutex upgraded = weak.upgrade();
+    ASSERT_TRUE(upgraded);
+    ASSERT_EQ(upgraded.lock()->value, 7);
+  }
+  second = nullptr;
+  ASSERT_EQ(tracked::live, 0);
+  ASSERT_TRUE(weak.expired());
+  ASSERT_FALSE(weak.upgrade());
+}
+
+// One thread upgrades a weak handle and then drops it while the other thread drops the
+// last original strong handle: the block must survive until the upgraded handle is gone.
+TEST(shared_rmutexTest, UpgradeRacesWithLastStrongRelease) {
+  for (int round = 0; round < 2000; ++round) {
+    auto                             owner = make_shared_rmutex<tracked, word_mutex>(round);
+    weak_rmutex<tracked, word_mutex> weak(owner);
+    std::thread                      upgrader([weak = std::move(weak), round]() mutable {
+      shared_rmutex upgraded = weak.upgrade();
+      weak                   = weak_rmutex<tracked, word_mutex>();  // Drops the weak count.
+      if (upgraded) {
+        EXPECT_EQ(upgraded.lock()->value, round);
+      }
+    });
+    owner.reset();
+    upgrader.join();
+    ASSERT_EQ(tracked::live, 0);
+  }
+}
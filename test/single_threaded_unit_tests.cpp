@@ -0,0 +1,77 @@
+// rmutex_lib/test/single_threaded_unit_tests.cpp
+
+#include <atomic>  // For std::atomic
+#include <thread>  // For std::thread
+#include <vector>  // For std::vector
+
+#include "gtest/gtest.h"
+
+#include "rmutexpp/rmutex.hpp"
+#include "rmutexpp/rmutex_backends.hpp"
+#include "rmutexpp/single_threaded.hpp"
+
+using namespace rmutexpp;
+
+class single_threadedTest : public ::testing::Test {
+  protected:
+    void TearDown() override { leave_single_threaded_mode(); }
+};
+
+TEST_F(single_threadedTest, BackendsWorkInSingleThreadedMode) {
+  rmutex<int, word_mutex> words { 0 };
+  rmutex<int, spin_mutex> spins { 0 };
+  enter_single_threaded_mode();
+  ASSERT_TRUE(single_threaded());
+  for (int i = 0; i < 100; ++i) {
+    ++*words.lock();
+    ++*spins.lock();
+  }
+  {
+    rmutex_ref held = words.lock();
+    ASSERT_FALSE(words.try_lock());
+  }
+  ASSERT_TRUE(spins.try_lock());
+  ASSERT_EQ(*words.lock(), 100);
+  ASSERT_EQ(*spins.lock(), 100);
+}
+
+TEST_F(single_threadedTest, LockHeldAcrossLeavingStaysValid) {
+  rmutex<int, word_mutex> words { 0 };
+  enter_single_threaded_mode();
+  {
+    rmutex_ref held = words.lock();
+    leave_single_threaded_mode();
+    ASSERT_FALSE(words.try_lock());
+    *held = 7;
+  }
+  ASSERT_EQ(*words.lock(), 7);
+}
+
+TEST_F(single_threadedTest, ThreadWrapperLeavesTheMode) {
+  rmutex<int, word_mutex> words { 0 };
+  enter_single_threaded_mode();
+  ++*words.lock();
+
+  std::vector<rmutexpp::thread> workers;
+  for (int t = 0; t < 4; ++t) {
+    workers.emplace_back([&] {
+      for (int i = 0; i < 1000; ++i) {
+        ++*words.lock();
+      }
+    });
+    ASSERT_FALSE(single_threaded());
+  }
+  for (rmutexpp::thread& worker : workers) {
+    worker.join();
+  }
+  ASSERT_EQ(*words.lock(), 4001);
+}
+
+TEST_F(single_threadedTest, WrapperPassesArguments) {
+  std::atomic<int> sum { 0 };
+  enter_single_threaded_mode();
+  rmutexpp::thread worker([&](int a, int b) { sum = a + b; }, 2, 3);
+  worker.join();
+  ASSERT_EQ(sum, 5);
+  ASSERT_FALSE(single_threaded());
+}